@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    KernelBenchmark.cpp
+    Created: 17 Oct 2026 2:30:55pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "KernelBenchmark.h"
+#include "../../Source/AnalysisKernels.h"
+
+namespace
+{
+    //Scratch shared by the workloads, sized for the largest frame at 96 kHz.
+    struct Scratch
+    {
+        juce::HeapBlock<float> frame;
+        juce::HeapBlock<float> window;
+        juce::HeapBlock<float> lags;
+    };
+
+    using WorkloadFunction = float (*)(const kernels::KernelSet&, const juce::AudioBuffer<float>&, double, Scratch&);
+
+    struct Workload
+    {
+        const char* name;
+        WorkloadFunction run;
+    };
+
+    //Hann window applied to STFT-sized frames, 4x overlap, both channels. No transform, only the window multiply.
+    float windowing(const kernels::KernelSet& set, const juce::AudioBuffer<float>& audio, double sampleRate, Scratch& scratch)
+    {
+        const int frameSize = juce::nextPowerOfTwo(juce::roundToInt(0.043 * sampleRate));
+        const int hopSize = frameSize / 4;
+        float sink = 0.0f;
+
+        for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+        {
+            for (int pos = 0; pos + frameSize <= audio.getNumSamples(); pos += hopSize)
+            {
+                set.multiply(scratch.frame, audio.getReadPointer(channel, pos), scratch.window, frameSize);
+                sink += scratch.frame[0];
+            }
+        }
+
+        return sink;
+    }
+
+    //Pitch-range autocorrelation (80 - 800 Hz) of 40 ms frames every 10 ms.
+    float autocorrelation(const kernels::KernelSet& set, const juce::AudioBuffer<float>& audio, double sampleRate, Scratch& scratch)
+    {
+        const int frameSize = juce::roundToInt(0.04 * sampleRate);
+        const int hopSize = juce::roundToInt(0.01 * sampleRate);
+        const int minLag = juce::roundToInt(sampleRate / 800.0);
+        const int maxLag = juce::jmin(frameSize / 2, juce::roundToInt(sampleRate / 80.0));
+        float sink = 0.0f;
+
+        for (int pos = 0; pos + frameSize <= audio.getNumSamples(); pos += hopSize)
+        {
+            kernels::autocorrelation(audio.getReadPointer(0, pos), frameSize, minLag, maxLag, scratch.lags, set);
+            sink += scratch.lags[0];
+        }
+
+        return sink;
+    }
+
+    //L/R cross-correlation over +-5 ms of 40 ms frames every 10 ms.
+    float crossCorrelation(const kernels::KernelSet& set, const juce::AudioBuffer<float>& audio, double sampleRate, Scratch& scratch)
+    {
+        const int frameSize = juce::roundToInt(0.04 * sampleRate);
+        const int hopSize = juce::roundToInt(0.01 * sampleRate);
+        const int maxLag = juce::roundToInt(0.005 * sampleRate);
+        float sink = 0.0f;
+
+        for (int pos = 0; pos + frameSize <= audio.getNumSamples(); pos += hopSize)
+        {
+            kernels::crossCorrelation(audio.getReadPointer(0, pos), audio.getReadPointer(1, pos), frameSize, maxLag, scratch.lags, set);
+            sink += scratch.lags[maxLag];
+        }
+
+        return sink;
+    }
+
+    //10 ms RMS envelope of both channels.
+    float rmsEnvelope(const kernels::KernelSet& set, const juce::AudioBuffer<float>& audio, double sampleRate, Scratch& scratch)
+    {
+        const int blockSize = juce::roundToInt(0.01 * sampleRate);
+        float sink = 0.0f;
+
+        for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+        {
+            kernels::rmsEnvelope(audio.getReadPointer(channel), audio.getNumSamples(), blockSize, scratch.lags, set);
+            sink += scratch.lags[0];
+        }
+
+        return sink;
+    }
+
+    const Workload workloads[] = {
+        { "windowing", windowing },
+        { "autocorrelation", autocorrelation },
+        { "crossCorrelation", crossCorrelation },
+        { "rmsEnvelope", rmsEnvelope }
+    };
+
+    void fillNoise(float* data, int numSamples, juce::Random& random)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = random.nextFloat() * 2.0f - 1.0f;
+    }
+
+    //==============================================================================
+    bool checkEquivalence(const kernels::KernelSet& set)
+    {
+        const auto& reference = kernels::getScalar();
+        const int lengths[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 64, 255, 1023, 4096, 4099 };
+
+        juce::HeapBlock<float> a(4099), b(4099), outSet(4099), outReference(4099);
+        juce::Random random(1234);
+        bool ok = true;
+
+        for (const int length : lengths)
+        {
+            fillNoise(a, length, random);
+            fillNoise(b, length, random);
+
+            //Errors are relative to the Cauchy-Schwarz bound, so cancelling sums do not fail spuriously.
+            const float squaresA = reference.sumOfSquares(a, length);
+            const float squaresB = reference.sumOfSquares(b, length);
+            const float scale = std::sqrt(squaresA * squaresB) + 1.0e-30f;
+
+            const float dotError = std::abs(set.dotProduct(a, b, length) - reference.dotProduct(a, b, length)) / scale;
+            const float squaresError = std::abs(set.sumOfSquares(a, length) - squaresA) / (squaresA + 1.0e-30f);
+
+            set.multiply(outSet, a, b, length);
+            reference.multiply(outReference, a, b, length);
+            const bool multiplyMatches = length == 0 || std::memcmp(outSet, outReference, sizeof(float) * (size_t)length) == 0;
+
+            if (dotError > kernels::tolerance || squaresError > kernels::tolerance || ! multiplyMatches)
+            {
+                std::printf("FAIL %s length %d: dotProduct %g, sumOfSquares %g, multiply %s\n",
+                            set.name, length, dotError, squaresError, multiplyMatches ? "ok" : "mismatch");
+                ok = false;
+            }
+        }
+
+        return ok;
+    }
+
+    double measureNsPerSample(const Workload& workload, const kernels::KernelSet& set, const juce::AudioBuffer<float>& audio,
+                              double sampleRate, Scratch& scratch, double minSeconds)
+    {
+        volatile float sink = workload.run(set, audio, sampleRate, scratch);
+
+        int iterations = 0;
+        const auto start = juce::Time::getHighResolutionTicks();
+        double elapsed = 0.0;
+
+        do
+        {
+            sink = sink + workload.run(set, audio, sampleRate, scratch);
+            ++iterations;
+            elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+        }
+        while (elapsed < minSeconds);
+
+        return elapsed * 1.0e9 / ((double)iterations * audio.getNumSamples());
+    }
+}
+
+//==============================================================================
+int runKernelBenchmark(const juce::ArgumentList& args)
+{
+    const double minSeconds = args.containsOption("--min-time")
+                            ? args.getValueForOption("--min-time").getDoubleValue()
+                            : 0.25;
+
+    const auto sets = kernels::getAvailable();
+    bool ok = true;
+
+    std::printf("Selected kernel set: %s\n", kernels::get().name);
+
+    for (const auto* set : sets)
+        ok = checkEquivalence(*set) && ok;
+
+    std::printf("Equivalence with scalar reference: %s\n\n", ok ? "ok" : "FAILED");
+    std::printf("%-18s %8s %8s %12s\n", "kernel", "rate", "set", "ns/sample");
+
+    const double sampleRates[] = { 44100.0, 48000.0, 96000.0 };
+    juce::Random random(42);
+
+    for (const double sampleRate : sampleRates)
+    {
+        //Two seconds of stereo noise, the default capture window.
+        juce::AudioBuffer<float> audio(2, juce::roundToInt(2.0 * sampleRate));
+
+        for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+            fillNoise(audio.getWritePointer(channel), audio.getNumSamples(), random);
+
+        Scratch scratch;
+        const int maxFrame = juce::nextPowerOfTwo(juce::roundToInt(0.043 * sampleRate));
+        scratch.frame.allocate((size_t)maxFrame, true);
+        scratch.window.allocate((size_t)maxFrame, true);
+        scratch.lags.allocate((size_t)audio.getNumSamples(), true);
+
+        for (int i = 0; i < maxFrame; ++i)
+            scratch.window[i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * i / maxFrame);
+
+        for (const auto& workload : workloads)
+            for (const auto* set : sets)
+                std::printf("%-18s %8.0f %8s %12.3f\n", workload.name, sampleRate, set->name,
+                            measureNsPerSample(workload, *set, audio, sampleRate, scratch, minSeconds));
+    }
+
+    return ok ? 0 : 1;
+}
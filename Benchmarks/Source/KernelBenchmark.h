@@ -0,0 +1,17 @@
+/*
+  ==============================================================================
+
+    KernelBenchmark.h
+    Created: 17 Oct 2026 2:30:55pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//Checks every available kernel set against the scalar reference, then prints
+//ns per input sample for each analysis workload at 44.1, 48 and 96 kHz.
+//Returns non-zero if any kernel is outside kernels::tolerance.
+int runKernelBenchmark(const juce::ArgumentList& args);
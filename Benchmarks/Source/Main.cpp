@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 2:30:55pm
+    Author:  Uditha
+
+    Console benchmarks for ChorusFind.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "KernelBenchmark.h"
+#include "ProcessorBenchmark.h"
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        std::printf("Usage: %s [--kernels] [--min-time=<seconds>]\n", args.executableName.toRawUTF8());
+        std::printf("       %s --processor [--corpus=<wav file|directory>] [--block-sizes=64,256,1024]\n"
+                    "           [--sample-rates=44100,48000] [--evaluate-every=<seconds>] [--backend=native|http]\n"
+                    "           [--mode=one-shot|continuous|timeline] [--realtime] [--json=<file>]\n", args.executableName.toRawUTF8());
+        return 0;
+    }
+
+    if (! args.containsOption("--processor"))
+        return runKernelBenchmark(args);
+
+    //The processor needs a running message loop for its timer and async calls,
+    //so the benchmark runs on its own thread while this one dispatches.
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    int result = 1;
+
+    juce::Thread::launch([&args, &result]
+    {
+        result = runProcessorBenchmark(args);
+        juce::MessageManager::getInstance()->stopDispatchLoop();
+    });
+
+    juce::MessageManager::getInstance()->runDispatchLoop();
+    return result;
+}
@@ -0,0 +1,455 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmark.cpp
+    Created: 18 Oct 2026 9:47:36pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ProcessorBenchmark.h"
+#include "../../Source/PluginProcessor.h"
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+ #pragma comment(lib, "psapi.lib")
+#elif JUCE_MAC
+ #include <sys/resource.h>
+#endif
+
+namespace
+{
+    struct Options
+    {
+        juce::Array<juce::File> files;
+        juce::Array<int> blockSizes{ 64, 256, 1024 };
+        juce::Array<double> sampleRates{ 44100.0, 48000.0 };
+        double evaluateEverySeconds = 5.0;
+        double resultTimeoutSeconds = 30.0;
+        bool realtime = false;
+        int backend = DetectionBackend::NATIVE;
+        int mode = DetectionMode::ONE_SHOT;
+        juce::File jsonFile;
+    };
+
+    struct Track
+    {
+        juce::String name;
+        juce::AudioBuffer<float> audio;
+        double sampleRate;
+    };
+
+    struct Stats
+    {
+        double mean = 0.0;
+        double p50 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double max = 0.0;
+    };
+
+    //==============================================================================
+    Stats computeStats(std::vector<double> values)
+    {
+        Stats stats;
+
+        if (values.empty())
+            return stats;
+
+        std::sort(values.begin(), values.end());
+
+        const auto at = [&values](double fraction)
+        {
+            return values[(size_t)juce::jlimit(0.0, (double)values.size() - 1.0, std::ceil(fraction * (double)values.size()) - 1.0)];
+        };
+
+        double sum = 0.0;
+
+        for (const double value : values)
+            sum += value;
+
+        stats.mean = sum / (double)values.size();
+        stats.p50 = at(0.5);
+        stats.p90 = at(0.9);
+        stats.p99 = at(0.99);
+        stats.p999 = at(0.999);
+        stats.max = values.back();
+        return stats;
+    }
+
+    juce::var toVar(const Stats& stats)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("mean", stats.mean);
+        object->setProperty("p50", stats.p50);
+        object->setProperty("p90", stats.p90);
+        object->setProperty("p99", stats.p99);
+        object->setProperty("p999", stats.p999);
+        object->setProperty("max", stats.max);
+        return object;
+    }
+
+    //Peak resident set size of the process, 0 where it cannot be read.
+    juce::int64 getPeakResidentBytes()
+    {
+       #if JUCE_WINDOWS
+        PROCESS_MEMORY_COUNTERS counters{};
+
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return (juce::int64)counters.PeakWorkingSetSize;
+       #elif JUCE_MAC
+        struct rusage usage{};
+
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+            return (juce::int64)usage.ru_maxrss;
+       #elif JUCE_LINUX
+        const auto status = juce::File("/proc/self/status").loadFileAsString();
+
+        for (const auto& line : juce::StringArray::fromLines(status))
+            if (line.startsWith("VmHWM:"))
+                return line.fromFirstOccurrenceOf(":", false, false).trim().getLargeIntValue() * 1024;
+       #endif
+
+        return 0;
+    }
+
+    //==============================================================================
+    juce::Array<int> parseIntList(const juce::String& text)
+    {
+        juce::Array<int> values;
+
+        for (const auto& item : juce::StringArray::fromTokens(text, ",", {}))
+            if (item.getIntValue() > 0)
+                values.add(item.getIntValue());
+
+        return values;
+    }
+
+    bool parseOptions(const juce::ArgumentList& args, Options& options)
+    {
+        if (args.containsOption("--corpus"))
+        {
+            const auto corpus = args.getExistingFileForOption("--corpus");
+
+            if (corpus.isDirectory())
+                options.files = corpus.findChildFiles(juce::File::findFiles, true, "*.wav");
+            else
+                options.files.add(corpus);
+        }
+
+        if (args.containsOption("--block-sizes"))
+            options.blockSizes = parseIntList(args.getValueForOption("--block-sizes"));
+
+        if (args.containsOption("--sample-rates"))
+        {
+            options.sampleRates.clear();
+
+            for (const int rate : parseIntList(args.getValueForOption("--sample-rates")))
+                options.sampleRates.add((double)rate);
+        }
+
+        if (args.containsOption("--evaluate-every"))
+            options.evaluateEverySeconds = args.getValueForOption("--evaluate-every").getDoubleValue();
+
+        if (args.containsOption("--backend"))
+            options.backend = parameters::backend.choices.indexOf(args.getValueForOption("--backend"), true);
+
+        if (args.containsOption("--mode"))
+            options.mode = parameters::mode.choices.indexOf(args.getValueForOption("--mode"), true);
+
+        if (args.containsOption("--json"))
+            options.jsonFile = args.getFileForOption("--json");
+
+        options.realtime = args.containsOption("--realtime");
+
+        return ! options.blockSizes.isEmpty() && ! options.sampleRates.isEmpty() && options.backend >= 0 && options.mode >= 0;
+    }
+
+    //==============================================================================
+    //Thirty seconds of stereo noise with a slow L/R delay wobble, used when no corpus is given.
+    void addSyntheticTrack(juce::OwnedArray<Track>& tracks)
+    {
+        auto* track = tracks.add(new Track{ "synthetic", juce::AudioBuffer<float>(2, 48000 * 30), 48000.0 });
+        juce::Random random(7);
+
+        auto* left = track->audio.getWritePointer(0);
+        auto* right = track->audio.getWritePointer(1);
+
+        for (int i = 0; i < track->audio.getNumSamples(); ++i)
+            left[i] = (random.nextFloat() * 2.0f - 1.0f) * 0.25f;
+
+        for (int i = 0; i < track->audio.getNumSamples(); ++i)
+        {
+            const float delay = 96.0f + 48.0f * std::sin(juce::MathConstants<float>::twoPi * 0.5f * i / 48000.0f);
+            const int index = juce::jmax(0, i - (int)delay);
+            right[i] = 0.7f * left[i] + 0.3f * left[index];
+        }
+    }
+
+    bool loadTracks(const Options& options, juce::OwnedArray<Track>& tracks)
+    {
+        if (options.files.isEmpty())
+        {
+            addSyntheticTrack(tracks);
+            return true;
+        }
+
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        for (const auto& file : options.files)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formats.createReaderFor(file));
+
+            if (reader == nullptr)
+            {
+                std::fprintf(stderr, "Cannot read %s\n", file.getFullPathName().toRawUTF8());
+                return false;
+            }
+
+            const int numChannels = juce::jlimit(2, capture::maxChannels, (int)reader->numChannels);
+            auto* track = tracks.add(new Track{ file.getFileName(), juce::AudioBuffer<float>(numChannels, (int)reader->lengthInSamples), reader->sampleRate });
+
+            //Mono files are fed to both channels.
+            reader->read(&track->audio, 0, (int)reader->lengthInSamples, 0, true, true);
+        }
+
+        return true;
+    }
+
+    juce::AudioBuffer<float> resample(const Track& track, double sampleRate)
+    {
+        if (track.sampleRate == sampleRate)
+            return track.audio;
+
+        const double ratio = track.sampleRate / sampleRate;
+        juce::AudioBuffer<float> result(track.audio.getNumChannels(), (int)(track.audio.getNumSamples() / ratio));
+
+        for (int channel = 0; channel < result.getNumChannels(); ++channel)
+        {
+            juce::LagrangeInterpolator interpolator;
+            interpolator.process(ratio, track.audio.getReadPointer(channel), result.getWritePointer(channel), result.getNumSamples());
+        }
+
+        return result;
+    }
+
+    //==============================================================================
+    void callOnMessageThread(std::function<void()> function)
+    {
+        juce::WaitableEvent done;
+
+        juce::MessageManager::callAsync([&function, &done]
+        {
+            function();
+            done.signal();
+        });
+
+        done.wait(-1);
+    }
+
+    void setParameter(juce::AudioProcessor& processor, const juce::String& id, float value)
+    {
+        for (auto* parameter : processor.getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(parameter))
+                if (ranged->getParameterID() == id)
+                    ranged->setValueNotifyingHost(ranged->convertTo0to1(value));
+    }
+
+    juce::var runOne(const Options& options, const Track& track, double sampleRate, int blockSize)
+    {
+        const auto audio = resample(track, sampleRate);
+
+        //Every run analyses from scratch: an earlier pass over the same file would otherwise turn
+        //time-to-result into a cache lookup, and nothing is written to the user's cache file.
+        juce::SharedResourcePointer<ResultCache> resultCache;
+        resultCache->setPersistent(false);
+        resultCache->clear();
+
+        std::unique_ptr<ChorusFindAudioProcessor> processor;
+        callOnMessageThread([&processor] { processor = std::make_unique<ChorusFindAudioProcessor>(); });
+
+        setParameter(*processor, parameters::backend.id, (float)options.backend);
+        setParameter(*processor, parameters::mode.id, (float)options.mode);
+
+        //Stems and immersive mixes run with their own channel layout, mono files as stereo.
+        const int numChannels = juce::jlimit(2, capture::maxChannels, audio.getNumChannels());
+        auto layout = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+
+        if (layout.isDisabled())
+            layout = juce::AudioChannelSet::discreteChannels(numChannels);
+
+        juce::AudioProcessor::BusesLayout buses;
+        buses.inputBuses.add(layout);
+        buses.outputBuses.add(layout);
+
+        if (! processor->setBusesLayout(buses))
+            processor->setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> block(numChannels, blockSize);
+        juce::MidiBuffer midi;
+
+        const int numBlocks = (audio.getNumSamples() + blockSize - 1) / blockSize;
+        const double blockSeconds = blockSize / sampleRate;
+        const int evaluateEveryBlocks = juce::jmax(1, (int)(options.evaluateEverySeconds / blockSeconds));
+
+        std::vector<double> blockMicroseconds;
+        std::vector<double> resultMilliseconds;
+        blockMicroseconds.reserve((size_t)numBlocks);
+
+        int numRequested = 0;
+        int numAbandoned = 0;
+        int numOverruns = 0;
+        bool pending = false;
+        int appliedBefore = 0;
+        int abandonedBefore = 0;
+        juce::int64 requestTicks = 0;
+
+        const auto processOne = [&](int position)
+        {
+            const int numSamples = juce::jlimit(0, blockSize, audio.getNumSamples() - position);
+            block.clear();
+
+            for (int channel = 0; channel < numChannels && numSamples > 0; ++channel)
+                block.copyFrom(channel, 0, audio, juce::jmin(channel, audio.getNumChannels() - 1), position, numSamples);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            processor->processBlock(block, midi);
+            const double elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            blockMicroseconds.push_back(elapsed * 1.0e6);
+
+            if (elapsed > blockSeconds)
+                ++numOverruns;
+        };
+
+        //An evaluation is done when its result has been applied. The state is READY again as soon as
+        //the window has been handed off, which says nothing about the result. One that ended without a
+        //result (no server, say) is counted but not timed.
+        const auto checkResult = [&]
+        {
+            if (pending && processor->getNumResultsApplied() > appliedBefore)
+            {
+                resultMilliseconds.push_back(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - requestTicks) * 1000.0);
+                pending = false;
+            }
+            else if (pending && processor->getNumEvaluationsAbandoned() > abandonedBefore)
+            {
+                ++numAbandoned;
+                pending = false;
+            }
+        };
+
+        const auto runStart = juce::Time::getHighResolutionTicks();
+
+        for (int index = 0; index < numBlocks; ++index)
+        {
+            if (index % evaluateEveryBlocks == evaluateEveryBlocks - 1 && ! pending && options.mode != DetectionMode::CONTINUOUS)
+            {
+                pending = true;
+                appliedBefore = processor->getNumResultsApplied();
+                abandonedBefore = processor->getNumEvaluationsAbandoned();
+                ++numRequested;
+                requestTicks = juce::Time::getHighResolutionTicks();
+                juce::MessageManager::callAsync([&processor] { processor->requestEvaluation(); });
+            }
+
+            processOne(index * blockSize);
+            checkResult();
+
+            if (options.realtime)
+            {
+                const double due = (index + 1) * blockSeconds;
+                const double now = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - runStart);
+
+                if (due > now)
+                    juce::Thread::sleep((int)((due - now) * 1000.0));
+            }
+        }
+
+        const double processingSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - runStart);
+
+        //Let the last evaluation finish, feeding silence in case it is still listening.
+        const auto waitStart = juce::Time::getHighResolutionTicks();
+
+        while (pending && juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - waitStart) < options.resultTimeoutSeconds)
+        {
+            processOne(audio.getNumSamples());
+            checkResult();
+            juce::Thread::sleep((int)std::ceil(blockSeconds * 1000.0));
+        }
+
+        processor->releaseResources();
+        callOnMessageThread([&processor] { processor.reset(); });
+
+        auto* run = new juce::DynamicObject();
+        run->setProperty("file", track.name);
+        run->setProperty("sampleRate", sampleRate);
+        run->setProperty("blockSize", blockSize);
+        run->setProperty("blocks", numBlocks);
+        run->setProperty("audioSeconds", audio.getNumSamples() / sampleRate);
+        run->setProperty("processingSeconds", processingSeconds);
+        run->setProperty("blockBudgetUs", blockSeconds * 1.0e6);
+        run->setProperty("blockLatencyUs", toVar(computeStats(blockMicroseconds)));
+        run->setProperty("overruns", numOverruns);
+        run->setProperty("evaluationsRequested", numRequested);
+        run->setProperty("evaluationsCompleted", (int)resultMilliseconds.size());
+        run->setProperty("evaluationsAbandoned", numAbandoned);
+        run->setProperty("timeToResultMs", toVar(computeStats(resultMilliseconds)));
+        run->setProperty("peakResidentBytes", getPeakResidentBytes());
+        return run;
+    }
+}
+
+//==============================================================================
+int runProcessorBenchmark(const juce::ArgumentList& args)
+{
+    Options options;
+
+    if (! parseOptions(args, options))
+    {
+        std::fprintf(stderr, "Invalid processor benchmark options\n");
+        return 1;
+    }
+
+    juce::OwnedArray<Track> tracks;
+
+    if (! loadTracks(options, tracks))
+        return 1;
+
+    juce::Array<juce::var> runs;
+
+    for (const auto* track : tracks)
+    {
+        for (const double sampleRate : options.sampleRates)
+        {
+            for (const int blockSize : options.blockSizes)
+            {
+                std::fprintf(stderr, "%s @ %.0f Hz, %d samples\n", track->name.toRawUTF8(), sampleRate, blockSize);
+                runs.add(runOne(options, *track, sampleRate, blockSize));
+            }
+        }
+    }
+
+    auto* report = new juce::DynamicObject();
+    report->setProperty("tool", "ChorusFindBench");
+    report->setProperty("backend", parameters::backend.choices[options.backend]);
+    report->setProperty("mode", parameters::mode.choices[options.mode]);
+    report->setProperty("realtime", options.realtime);
+    report->setProperty("cpu", juce::SystemStats::getCpuModel());
+    report->setProperty("runs", runs);
+
+    const auto json = juce::JSON::toString(juce::var(report));
+
+    if (options.jsonFile != juce::File())
+        return options.jsonFile.replaceWithText(json) ? 0 : 1;
+
+    std::printf("%s\n", json.toRawUTF8());
+    return 0;
+}
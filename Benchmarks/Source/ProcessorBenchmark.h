@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    ProcessorBenchmark.h
+    Created: 18 Oct 2026 9:47:36pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//Runs ChorusFindAudioProcessor headless over a WAV corpus at every combination
+//of the given block sizes and sample rates, triggering evaluations along the way.
+//Writes per-block latency percentiles, time-to-result and memory use as JSON.
+//Must be called on a thread other than the message thread, which has to keep
+//dispatching while the benchmark runs.
+int runProcessorBenchmark(const juce::ArgumentList& args);
@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+
+    AnalysisClient.cpp
+    Created: 17 Oct 2026 7:31:46pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "AnalysisClient.h"
+#include "Config.h"
+#include "RealtimeChecks.h"
+#include "UploadEncoder.h"
+
+//==============================================================================
+DeadlineWatchdog::DeadlineWatchdog()
+    : juce::Thread("ChorusFind request watchdog")
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+DeadlineWatchdog::~DeadlineWatchdog()
+{
+    stopThread(2000);
+}
+
+void DeadlineWatchdog::watch(AnalysisClient* client, int timeoutMs)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        entries.add({ client, juce::Time::getMillisecondCounter() + (juce::uint32)timeoutMs });
+    }
+
+    notify();
+}
+
+void DeadlineWatchdog::unwatch(AnalysisClient* client)
+{
+    const juce::ScopedLock sl(lock);
+    entries.removeIf([client](const Entry& entry) { return entry.client == client; });
+}
+
+void DeadlineWatchdog::run()
+{
+    while (! threadShouldExit())
+    {
+        int waitMs = -1;
+
+        {
+            const juce::ScopedLock sl(lock);
+            const auto now = juce::Time::getMillisecondCounter();
+
+            for (int i = entries.size(); --i >= 0;)
+            {
+                const auto entry = entries.getReference(i);
+
+                if ((int)(entry.deadline - now) <= 0)
+                {
+                    entry.client->expire();
+                    entries.remove(i);
+                }
+                else
+                {
+                    const int remaining = (int)(entry.deadline - now);
+                    waitMs = waitMs < 0 ? remaining : juce::jmin(waitMs, remaining);
+                }
+            }
+        }
+
+        wait(waitMs);
+    }
+}
+
+//==============================================================================
+AnalysisClient::AnalysisClient()
+    : juce::Thread("ChorusFind analysis client")
+    , endpoint(api::url)
+    , timeoutMs(api::timeoutMs)
+{
+    startThread(juce::Thread::Priority::low);
+}
+
+AnalysisClient::~AnalysisClient()
+{
+    cancel(true);
+    stopThread(api::timeoutMs);
+}
+
+void AnalysisClient::setEndpoint(const juce::String& url)
+{
+    const juce::ScopedLock sl(lock);
+    endpoint = url;
+}
+
+juce::String AnalysisClient::getEndpoint() const
+{
+    const juce::ScopedLock sl(lock);
+    return endpoint;
+}
+
+void AnalysisClient::setTimeoutMs(int newTimeoutMs)
+{
+    const juce::ScopedLock sl(lock);
+    timeoutMs = newTimeoutMs;
+}
+
+void AnalysisClient::post(const juce::MemoryBlock& data, int format, Callback onComplete)
+{
+    CHORUSFIND_RT_UNSAFE("AnalysisClient::post")
+
+    const auto url = juce::URL(getEndpoint()).withDataToUpload("audio", UploadEncoder::getFileName(format), data, UploadEncoder::getMimeType(format));
+    enqueue(url, juce::String(upload::formatHeader) + ": " + UploadEncoder::getWireName(format), true, std::move(onComplete));
+}
+
+void AnalysisClient::postChunk(const juce::URL& url, const juce::MemoryBlock& data, int format, bool isFinal, Callback onComplete)
+{
+    CHORUSFIND_RT_UNSAFE("AnalysisClient::postChunk")
+
+    enqueue(url.withPOSTData(data),
+            "Content-Type: " + UploadEncoder::getMimeType(format) + "\r\n" + upload::formatHeader + ": " + UploadEncoder::getWireName(format),
+            isFinal, std::move(onComplete));
+}
+
+void AnalysisClient::enqueue(const juce::URL& url, const juce::String& headers, bool expectsResult, Callback onComplete)
+{
+    Callback superseded;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (hasPending)
+            superseded = std::move(pendingCallback);
+
+        pendingUrl = url;
+        pendingHeaders = headers;
+        pendingExpectsResult = expectsResult;
+        pendingCallback = std::move(onComplete);
+        hasPending = true;
+
+        abortActive(Result::Status::cancelled);
+    }
+
+    if (superseded != nullptr)
+    {
+        Result result;
+        result.status = Result::Status::cancelled;
+        result.message = "Superseded by a newer request.";
+        superseded(result);
+    }
+
+    notify();
+}
+
+void AnalysisClient::cancel(bool discardCallbacks)
+{
+    Callback queued;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (hasPending)
+        {
+            queued = std::move(pendingCallback);
+            pendingCallback = nullptr;
+            hasPending = false;
+        }
+
+        abortActive(Result::Status::cancelled);
+
+        if (discardCallbacks)
+        {
+            activeCallback = nullptr;
+            queued = nullptr;
+        }
+    }
+
+    //Waits for a callback that the client thread took before the cancel and is calling right now.
+    {
+        const juce::ScopedLock cl(callbackLock);
+    }
+
+    if (queued != nullptr)
+    {
+        Result result;
+        result.status = Result::Status::cancelled;
+        queued(result);
+    }
+}
+
+void AnalysisClient::expire()
+{
+    const juce::ScopedLock sl(lock);
+    abortActive(Result::Status::timedOut);
+}
+
+void AnalysisClient::abortActive(Result::Status reason)
+{
+    //Called with the lock held. The first reason wins.
+    if (! inFlight || abortReason != Result::Status::ok)
+        return;
+
+    abortReason = reason;
+
+    if (activeStream != nullptr)
+        activeStream->cancel();
+}
+
+void AnalysisClient::run()
+{
+    while (! threadShouldExit())
+    {
+        juce::URL url;
+        juce::String headers;
+        bool expectsResult = true;
+        int requestTimeoutMs = 0;
+
+        {
+            const juce::ScopedLock sl(lock);
+
+            if (hasPending)
+            {
+                url = pendingUrl;
+                headers = pendingHeaders;
+                expectsResult = pendingExpectsResult;
+                activeCallback = std::move(pendingCallback);
+                pendingCallback = nullptr;
+                hasPending = false;
+
+                inFlight = true;
+                abortReason = Result::Status::ok;
+                requestTimeoutMs = timeoutMs;
+            }
+        }
+
+        if (requestTimeoutMs == 0)
+        {
+            wait(-1);
+            continue;
+        }
+
+        const auto result = perform(url, headers, expectsResult, requestTimeoutMs);
+
+        //Held while the callback runs, but not the lock, so cancel() can wait for it and the callback
+        //can still post. Taken first, so a cancel() cannot slip in between and miss the wait.
+        const juce::ScopedLock cl(callbackLock);
+        Callback callback;
+
+        {
+            const juce::ScopedLock sl(lock);
+            callback = std::move(activeCallback);
+            activeCallback = nullptr;
+            inFlight = false;
+        }
+
+        if (callback != nullptr)
+            callback(result);
+    }
+}
+
+AnalysisClient::Result AnalysisClient::perform(const juce::URL& url, const juce::String& headers, bool expectsResult, int requestTimeoutMs)
+{
+    Result result;
+
+    //POST, so the form data or the chunk goes in the request body.
+    juce::WebInputStream stream(url, true);
+    stream.withExtraHeaders(headers)
+          .withConnectionTimeout(requestTimeoutMs);
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        if (abortReason != Result::Status::ok)
+        {
+            result.status = abortReason;
+            return result;
+        }
+
+        activeStream = &stream;
+    }
+
+    watchdog->watch(this, requestTimeoutMs);
+
+    const auto startMs = juce::Time::getMillisecondCounterHiRes();
+    const bool connected = stream.connect(nullptr);
+    juce::String response;
+
+    if (connected && ! stream.isError())
+        response = stream.readEntireStreamAsString();
+
+    watchdog->unwatch(this);
+
+    result.roundTripMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    result.httpStatusCode = stream.getStatusCode();
+
+    {
+        const juce::ScopedLock sl(lock);
+        activeStream = nullptr;
+
+        if (abortReason != Result::Status::ok)
+        {
+            result.status = abortReason;
+            result.message = abortReason == Result::Status::timedOut
+                           ? "No answer within " + juce::String(requestTimeoutMs) + " ms."
+                           : "Request cancelled.";
+            return result;
+        }
+    }
+
+    if (! connected || stream.isError())
+    {
+        result.status = Result::Status::connectionFailed;
+        result.message = "Could not reach " + url.toString(false);
+        return result;
+    }
+
+    if (result.httpStatusCode != 200)
+    {
+        result.status = Result::Status::httpError;
+        result.message = "Server answered with status " + juce::String(result.httpStatusCode);
+        result.acceptedFormats = juce::StringArray::fromTokens(stream.getResponseHeaders()[upload::acceptHeader], ",", {});
+        return result;
+    }
+
+    //An intermediate chunk, the server only confirms it.
+    if (! expectsResult)
+    {
+        result.status = Result::Status::ok;
+        return result;
+    }
+
+    const juce::var parsed = juce::JSON::parse(response);
+    const juce::var value = parsed.getProperty("result", {});
+
+    if (! (value.isDouble() || value.isInt()))
+    {
+        result.status = Result::Status::badResponse;
+        result.message = "Unexpected response: " + response.substring(0, 200);
+        return result;
+    }
+
+    result.status = Result::Status::ok;
+    result.value = juce::jlimit(0.0f, 1.0f, (float)(double)value);
+    return result;
+}
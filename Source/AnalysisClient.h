@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    AnalysisClient.h
+    Created: 17 Oct 2026 7:31:46pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class AnalysisClient;
+
+//==============================================================================
+/**
+    One thread per process that cancels requests which run past their deadline.
+    Shared by all AnalysisClients through a SharedResourcePointer.
+*/
+class DeadlineWatchdog : private juce::Thread
+{
+public:
+    DeadlineWatchdog();
+    ~DeadlineWatchdog() override;
+
+    void watch(AnalysisClient* client, int timeoutMs);
+    void unwatch(AnalysisClient* client);
+
+private:
+    void run() override;
+
+    struct Entry
+    {
+        AnalysisClient* client;
+        juce::uint32 deadline;
+    };
+
+    juce::CriticalSection lock;
+    juce::Array<Entry> entries;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeadlineWatchdog)
+};
+
+//==============================================================================
+/**
+    Asynchronous HTTP client for the analysis server.
+
+    Each processor owns one. Requests run on the client's own long-lived thread,
+    so pool workers never block on the network. Every request opens its own
+    connection: a WebInputStream cannot be reused. Every request has a
+    deadline enforced by a process-wide watchdog. Posting again or destroying
+    the client cancels the request in flight. The outcome is reported as a
+    typed Result instead of a bare float.
+*/
+class AnalysisClient : private juce::Thread
+{
+public:
+    struct Result
+    {
+        enum class Status
+        {
+            ok,
+            timedOut,
+            cancelled,
+            connectionFailed,
+            httpError,
+            badResponse
+        };
+
+        Status status = Status::connectionFailed;
+        float value = 0.5f;
+        int httpStatusCode = 0;
+        double roundTripMs = 0.0;
+        juce::String message;
+
+        //Formats the server listed when it rejected the body's format (status 415).
+        juce::StringArray acceptedFormats;
+
+        bool succeeded() const { return status == Status::ok; }
+    };
+
+    using Callback = std::function<void(const Result&)>;
+
+    AnalysisClient();
+    ~AnalysisClient() override;
+
+    void setEndpoint(const juce::String& url);
+    juce::String getEndpoint() const;
+
+    //Deadline for the whole request: connect, upload, server time and response.
+    void setTimeoutMs(int newTimeoutMs);
+
+    //Uploads an encoded window (format is an UploadFormat) as the "audio" form field, naming
+    //the format in upload::formatHeader. A request still in flight is cancelled first and
+    //its callback receives Status::cancelled.
+    //onComplete is called on the client thread, except for a queued request that
+    //is superseded before it started, which completes on the calling thread.
+    void post(const juce::MemoryBlock& data, int format, Callback onComplete);
+
+    //Sends one chunk of a streamed upload as the raw request body to url, which carries the
+    //session and sequence. Only the final chunk is answered with a result, the others succeed
+    //on status 200 alone. Otherwise as post().
+    void postChunk(const juce::URL& url, const juce::MemoryBlock& data, int format, bool isFinal, Callback onComplete);
+
+    //Cancels the queued and in-flight requests. With discardCallbacks their
+    //callbacks are not called at all, which is what an owner being destroyed wants.
+    //Returns only once a callback already running on the client thread has returned,
+    //so callbacks must not wait for the thread that cancels.
+    void cancel(bool discardCallbacks = false);
+
+private:
+    friend class DeadlineWatchdog;
+
+    void run() override;
+    void enqueue(const juce::URL& url, const juce::String& headers, bool expectsResult, Callback onComplete);
+    Result perform(const juce::URL& url, const juce::String& headers, bool expectsResult, int requestTimeoutMs);
+    void expire();
+    void abortActive(Result::Status reason);
+
+    juce::SharedResourcePointer<DeadlineWatchdog> watchdog;
+
+    mutable juce::CriticalSection lock;
+    juce::CriticalSection callbackLock;
+    juce::String endpoint;
+    int timeoutMs;
+
+    //Latest request waiting for the thread
+    juce::URL pendingUrl;
+    juce::String pendingHeaders;
+    bool pendingExpectsResult = true;
+    Callback pendingCallback;
+    bool hasPending = false;
+
+    //Request in flight
+    bool inFlight = false;
+    Callback activeCallback;
+    juce::WebInputStream* activeStream = nullptr;
+    Result::Status abortReason = Result::Status::ok;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisClient)
+};
@@ -0,0 +1,285 @@
+/*
+  ==============================================================================
+
+    AnalysisKernels.cpp
+    Created: 17 Oct 2026 1:42:10pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "AnalysisKernels.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+ #if JUCE_MSVC
+  #define CHORUSFIND_TARGET_SSE
+  #define CHORUSFIND_TARGET_AVX2
+ #else
+  #define CHORUSFIND_TARGET_SSE  __attribute__((target("sse2")))
+  #define CHORUSFIND_TARGET_AVX2 __attribute__((target("avx2,fma")))
+ #endif
+#elif JUCE_ARM && (defined (__ARM_NEON) || defined (__ARM_NEON__) || defined (_M_ARM64))
+ #include <arm_neon.h>
+ #define CHORUSFIND_HAS_NEON 1
+#endif
+
+namespace kernels
+{
+    //==============================================================================
+    namespace scalar
+    {
+        static float dotProduct(const float* a, const float* b, int numSamples)
+        {
+            float sum = 0.0f;
+
+            for (int i = 0; i < numSamples; ++i)
+                sum += a[i] * b[i];
+
+            return sum;
+        }
+
+        static float sumOfSquares(const float* a, int numSamples)
+        {
+            return dotProduct(a, a, numSamples);
+        }
+
+        static void multiply(float* dest, const float* a, const float* b, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                dest[i] = a[i] * b[i];
+        }
+
+        static const KernelSet set{ "scalar", dotProduct, sumOfSquares, multiply };
+    }
+
+   #if JUCE_INTEL
+    //==============================================================================
+    namespace sse
+    {
+        CHORUSFIND_TARGET_SSE static float dotProduct(const float* a, const float* b, int numSamples)
+        {
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+            }
+
+            for (; i + 4 <= numSamples; i += 4)
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+            float lanes[4];
+            _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+            float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            for (; i < numSamples; ++i)
+                sum += a[i] * b[i];
+
+            return sum;
+        }
+
+        CHORUSFIND_TARGET_SSE static float sumOfSquares(const float* a, int numSamples)
+        {
+            return dotProduct(a, a, numSamples);
+        }
+
+        CHORUSFIND_TARGET_SSE static void multiply(float* dest, const float* a, const float* b, int numSamples)
+        {
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+
+            for (; i < numSamples; ++i)
+                dest[i] = a[i] * b[i];
+        }
+
+        static const KernelSet set{ "sse", dotProduct, sumOfSquares, multiply };
+    }
+
+    //==============================================================================
+    namespace avx2
+    {
+        CHORUSFIND_TARGET_AVX2 static float dotProduct(const float* a, const float* b, int numSamples)
+        {
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+            int i = 0;
+
+            for (; i + 16 <= numSamples; i += 16)
+            {
+                acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+                acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+            }
+
+            for (; i + 8 <= numSamples; i += 8)
+                acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+
+            acc0 = _mm256_add_ps(acc0, acc1);
+            const __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+
+            float lanes[4];
+            _mm_storeu_ps(lanes, half);
+            float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            for (; i < numSamples; ++i)
+                sum += a[i] * b[i];
+
+            return sum;
+        }
+
+        CHORUSFIND_TARGET_AVX2 static float sumOfSquares(const float* a, int numSamples)
+        {
+            return dotProduct(a, a, numSamples);
+        }
+
+        CHORUSFIND_TARGET_AVX2 static void multiply(float* dest, const float* a, const float* b, int numSamples)
+        {
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+                _mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+
+            for (; i < numSamples; ++i)
+                dest[i] = a[i] * b[i];
+        }
+
+        static const KernelSet set{ "avx2", dotProduct, sumOfSquares, multiply };
+    }
+   #endif
+
+   #if CHORUSFIND_HAS_NEON
+    //==============================================================================
+    namespace neon
+    {
+        static float dotProduct(const float* a, const float* b, int numSamples)
+        {
+            float32x4_t acc0 = vdupq_n_f32(0.0f);
+            float32x4_t acc1 = vdupq_n_f32(0.0f);
+            int i = 0;
+
+            for (; i + 8 <= numSamples; i += 8)
+            {
+                acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+                acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+            }
+
+            for (; i + 4 <= numSamples; i += 4)
+                acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+
+            float lanes[4];
+            vst1q_f32(lanes, vaddq_f32(acc0, acc1));
+            float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            for (; i < numSamples; ++i)
+                sum += a[i] * b[i];
+
+            return sum;
+        }
+
+        static float sumOfSquares(const float* a, int numSamples)
+        {
+            return dotProduct(a, a, numSamples);
+        }
+
+        static void multiply(float* dest, const float* a, const float* b, int numSamples)
+        {
+            int i = 0;
+
+            for (; i + 4 <= numSamples; i += 4)
+                vst1q_f32(dest + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+
+            for (; i < numSamples; ++i)
+                dest[i] = a[i] * b[i];
+        }
+
+        static const KernelSet set{ "neon", dotProduct, sumOfSquares, multiply };
+    }
+   #endif
+
+    //==============================================================================
+    juce::Array<const KernelSet*> getAvailable()
+    {
+        juce::Array<const KernelSet*> sets{ &scalar::set };
+
+       #if JUCE_INTEL
+        if (juce::SystemStats::hasSSE2())
+            sets.add(&sse::set);
+
+        if (juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3())
+            sets.add(&avx2::set);
+       #elif CHORUSFIND_HAS_NEON
+        sets.add(&neon::set);
+       #endif
+
+        return sets;
+    }
+
+    const KernelSet& get()
+    {
+        //Last available set is the widest one.
+        static const KernelSet& selected = *getAvailable().getLast();
+        return selected;
+    }
+
+    const KernelSet& getScalar()
+    {
+        return scalar::set;
+    }
+
+    //==============================================================================
+    void crossCorrelation(const float* a, const float* b, int numSamples, int maxLag, float* out, const KernelSet& set)
+    {
+        jassert(maxLag < numSamples);
+
+        for (int lag = -maxLag; lag <= maxLag; ++lag)
+        {
+            out[lag + maxLag] = lag >= 0 ? set.dotProduct(a, b + lag, numSamples - lag)
+                                         : set.dotProduct(a - lag, b, numSamples + lag);
+        }
+    }
+
+    void autocorrelation(const float* a, int numSamples, int minLag, int maxLag, float* out, const KernelSet& set)
+    {
+        jassert(minLag >= 0 && maxLag < numSamples);
+
+        for (int lag = minLag; lag <= maxLag; ++lag)
+            out[lag - minLag] = set.dotProduct(a, a + lag, numSamples - lag);
+    }
+
+    int rmsEnvelope(const float* a, int numSamples, int blockSize, float* out, const KernelSet& set)
+    {
+        const int numBlocks = numSamples / blockSize;
+
+        for (int block = 0; block < numBlocks; ++block)
+            out[block] = std::sqrt(set.sumOfSquares(a + block * blockSize, blockSize) / blockSize);
+
+        return numBlocks;
+    }
+
+    void matrixMultiply(const float* a, int aStride, const float* b, int k, float* out, int outStride, int m, int n,
+                        const KernelSet& set)
+    {
+        //About 16 KB of b per tile, and a few dozen rows of a between tile switches.
+        constexpr int rowsPerTile = 32;
+        const int columnsPerTile = juce::jmax(1, 4096 / juce::jmax(1, k));
+
+        for (int column = 0; column < n; column += columnsPerTile)
+        {
+            const int lastColumn = juce::jmin(n, column + columnsPerTile);
+
+            for (int row = 0; row < m; row += rowsPerTile)
+            {
+                const int lastRow = juce::jmin(m, row + rowsPerTile);
+
+                for (int i = row; i < lastRow; ++i)
+                    for (int j = column; j < lastColumn; ++j)
+                        out[i * outStride + j] = set.dotProduct(a + i * aStride, b + j * k, k);
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    AnalysisKernels.h
+    Created: 17 Oct 2026 1:42:10pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Inner loops of the analysis code.
+
+    Every kernel has a scalar reference and SSE / AVX2 / NEON versions. The
+    fastest one the CPU supports is picked once at runtime, callers just use the
+    free functions below. Vector versions sum in a different order, so results
+    match the scalar reference to rounding (see kernels::tolerance), not bit
+    for bit.
+*/
+namespace kernels
+{
+    struct KernelSet
+    {
+        const char* name;
+
+        //sum(a[i] * b[i])
+        float (*dotProduct)(const float* a, const float* b, int numSamples);
+
+        //sum(a[i] * a[i])
+        float (*sumOfSquares)(const float* a, int numSamples);
+
+        //dest[i] = a[i] * b[i]
+        void (*multiply)(float* dest, const float* a, const float* b, int numSamples);
+    };
+
+    //Relative error allowed between a vector kernel and the scalar reference.
+    static constexpr float tolerance = 1.0e-4f;
+
+    //The set selected for this CPU.
+    const KernelSet& get();
+
+    //Scalar reference, always available.
+    const KernelSet& getScalar();
+
+    //Every set this CPU can run, scalar first.
+    juce::Array<const KernelSet*> getAvailable();
+
+    inline float dotProduct(const float* a, const float* b, int numSamples)
+    {
+        return get().dotProduct(a, b, numSamples);
+    }
+
+    inline float sumOfSquares(const float* a, int numSamples)
+    {
+        return get().sumOfSquares(a, numSamples);
+    }
+
+    inline void multiply(float* dest, const float* a, const float* b, int numSamples)
+    {
+        get().multiply(dest, a, b, numSamples);
+    }
+
+    //==============================================================================
+    //Composite kernels built on a set, the selected one unless told otherwise.
+
+    //out[k + maxLag] = sum(a[i] * b[i + k]) for k in [-maxLag, maxLag]. out holds 2 * maxLag + 1 values.
+    void crossCorrelation(const float* a, const float* b, int numSamples, int maxLag, float* out, const KernelSet& set = get());
+
+    //out[k - minLag] = sum(a[i] * a[i + k]) for k in [minLag, maxLag].
+    void autocorrelation(const float* a, int numSamples, int minLag, int maxLag, float* out, const KernelSet& set = get());
+
+    //RMS of consecutive blocks. Writes numSamples / blockSize values and returns that count.
+    int rmsEnvelope(const float* a, int numSamples, int blockSize, float* out, const KernelSet& set = get());
+
+    //out[i * outStride + j] = sum(a[i * aStride + x] * b[j * k + x]) for x in [0, k), i in [0, m), j in [0, n).
+    //b holds n rows of k values (a weight matrix as outputs x inputs). Rows of a may overlap (aStride < k),
+    //which turns a 1-D convolution over frames into a single product. Tiled so a block of b stays in cache
+    //while every row of a passes it.
+    void matrixMultiply(const float* a, int aStride, const float* b, int k, float* out, int outStride, int m, int n,
+                        const KernelSet& set = get());
+}
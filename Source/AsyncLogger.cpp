@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    AsyncLogger.cpp
+    Created: 18 Oct 2026 1:26:52pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "AsyncLogger.h"
+
+AsyncLogger::AsyncLogger()
+    : juce::Thread("ChorusFind logger")
+{
+    const auto levelName = juce::SystemStats::getEnvironmentVariable(logging::levelVariable, {}).trim().toLowerCase();
+
+    for (auto level : { Level::debug, Level::info, Level::warning, Level::error, Level::off })
+        if (levelName == getLevelName(level))
+            setLevel(level);
+
+    const auto filePath = juce::SystemStats::getEnvironmentVariable(logging::fileVariable, {});
+
+    if (juce::File::isAbsolutePath(filePath))
+        setLogFile(juce::File(filePath));
+
+    startThread(juce::Thread::Priority::low);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    stopThread(2000);
+
+    //Whatever is still queued.
+    drain();
+}
+
+const char* AsyncLogger::getLevelName(Level level) noexcept
+{
+    switch (level)
+    {
+    case Level::debug:      return "debug";
+    case Level::info:       return "info";
+    case Level::warning:    return "warning";
+    case Level::error:      return "error";
+    case Level::off:        return "off";
+    default:                return "unknown";
+    }
+}
+
+void AsyncLogger::log(Level level, const char* message) noexcept
+{
+    if (! isEnabled(level))
+        return;
+
+    Record record;
+    record.level = level;
+    record.timeMs = juce::Time::getMillisecondCounter();
+    record.format = message;
+    push(record);
+}
+
+void AsyncLogger::log(Level level, const char* format, double value) noexcept
+{
+    if (! isEnabled(level))
+        return;
+
+    Record record;
+    record.level = level;
+    record.timeMs = juce::Time::getMillisecondCounter();
+    record.format = format;
+    record.value = value;
+    record.hasValue = true;
+    push(record);
+}
+
+void AsyncLogger::log(Level level, const juce::String& text)
+{
+    if (! isEnabled(level))
+        return;
+
+    Record record;
+    record.level = level;
+    record.timeMs = juce::Time::getMillisecondCounter();
+    text.copyToUTF8(record.text, sizeof(record.text));
+    push(record);
+}
+
+void AsyncLogger::push(const Record& record) noexcept
+{
+    if (! records.push(record))
+        ++numDropped;
+}
+
+void AsyncLogger::setLevel(Level newLevel) noexcept
+{
+    minLevel = newLevel;
+}
+
+AsyncLogger::Level AsyncLogger::getLevel() const noexcept
+{
+    return minLevel.load();
+}
+
+void AsyncLogger::setLogFile(const juce::File& file)
+{
+    const juce::ScopedLock sl(fileLock);
+    logFile = file;
+    logFileChanged = true;
+}
+
+juce::uint32 AsyncLogger::getNumDropped() const noexcept
+{
+    return numDropped.load();
+}
+
+void AsyncLogger::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(logging::flushIntervalMs);
+    }
+}
+
+void AsyncLogger::drain()
+{
+    {
+        const juce::ScopedLock sl(fileLock);
+
+        if (logFileChanged)
+        {
+            logFileChanged = false;
+            fileStream.reset();
+
+            if (logFile != juce::File())
+            {
+                fileStream = std::make_unique<juce::FileOutputStream>(logFile);
+
+                if (! fileStream->openedOk())
+                    fileStream.reset();
+            }
+        }
+    }
+
+    const auto dropped = numDropped.load();
+    Record record;
+    bool wroteToFile = false;
+
+    const auto write = [this, &wroteToFile](const juce::String& line)
+    {
+        juce::Logger::writeToLog(line);
+
+        if (fileStream != nullptr)
+        {
+            fileStream->writeText(line + juce::newLine, false, false, nullptr);
+            wroteToFile = true;
+        }
+    };
+
+    while (records.pop(record))
+    {
+        juce::String message;
+
+        if (record.format == nullptr)
+            message = juce::String::fromUTF8(record.text);
+        else if (record.hasValue)
+            message = juce::String::formatted(record.format, record.value);
+        else
+            message = record.format;
+
+        write(juce::String(record.timeMs) + " [" + getLevelName(record.level) + "] " + message);
+    }
+
+    if (dropped != numDroppedReported)
+    {
+        write("[warning] " + juce::String(dropped - numDroppedReported) + " log messages dropped, the queue was full");
+        numDroppedReported = dropped;
+    }
+
+    if (wroteToFile)
+        fileStream->flush();
+}
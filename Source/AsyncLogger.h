@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    AsyncLogger.h
+    Created: 18 Oct 2026 1:26:52pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+#include "LockFreeQueue.h"
+
+//==============================================================================
+/**
+    Logger that is safe to call from the audio thread.
+
+    Callers copy a fixed-size record into a preallocated lock-free queue. A
+    low-priority thread formats the records and writes them to juce::Logger and,
+    if set, a log file. Messages below the current level are skipped before
+    they are queued, messages that find the queue full are counted as dropped.
+
+    One per process, hold it through a SharedResourcePointer.
+*/
+class AsyncLogger : private juce::Thread
+{
+public:
+    enum class Level
+    {
+        debug,
+        info,
+        warning,
+        error,
+        off
+    };
+
+    AsyncLogger();
+    ~AsyncLogger() override;
+
+    //Any thread, never blocks or allocates. message must be a string literal.
+    void log(Level level, const char* message) noexcept;
+
+    //Same, with one number formatted into message (a printf format, e.g. "%g") by the logger thread.
+    void log(Level level, const char* format, double value) noexcept;
+
+    //Not for the audio thread: the text is copied, truncated to logging::maxMessageLength.
+    void log(Level level, const juce::String& text);
+
+    void setLevel(Level newLevel) noexcept;
+    Level getLevel() const noexcept;
+
+    //An empty file logs to juce::Logger only.
+    void setLogFile(const juce::File& file);
+
+    //Messages lost because the queue was full, since startup.
+    juce::uint32 getNumDropped() const noexcept;
+
+    static const char* getLevelName(Level level) noexcept;
+
+private:
+    void run() override;
+    void drain();
+
+    bool isEnabled(Level level) const noexcept
+    {
+        return level >= minLevel.load(std::memory_order_relaxed) && level != Level::off;
+    }
+
+    struct Record
+    {
+        Level level = Level::info;
+        juce::uint32 timeMs = 0;
+
+        //Either a literal (with an optional value) or copied text.
+        const char* format = nullptr;
+        double value = 0.0;
+        bool hasValue = false;
+        char text[logging::maxMessageLength] = {};
+    };
+
+    void push(const Record& record) noexcept;
+
+    MpscQueue<Record, logging::queueSize> records;
+    std::atomic<Level> minLevel{ Level::info };
+    std::atomic<juce::uint32> numDropped{ 0 };
+    juce::uint32 numDroppedReported = 0;
+
+    //Log file, handed to the logger thread under the lock.
+    juce::CriticalSection fileLock;
+    juce::File logFile;
+    bool logFileChanged = false;
+    std::unique_ptr<juce::FileOutputStream> fileStream;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AsyncLogger)
+};
@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    CaptureBuffer.h
+    Created: 17 Oct 2026 10:05:12am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Always-on capture ring.
+
+    The audio thread is the only writer and pushes every block into it, so an
+    evaluation can take the last few seconds of audio straight away instead of
+    waiting for a fresh recording. Readers copy ranges out of it from any other
+    thread and find out afterwards whether the writer overtook them.
+
+    All memory is allocated in prepare(); push() never allocates or locks.
+*/
+class CaptureRingBuffer
+{
+public:
+    CaptureRingBuffer() = default;
+
+    //Allocates the ring. Call from prepareToPlay only, never while processBlock can run.
+    void prepare(int numChannels, int capacityInSamples)
+    {
+        buffer.setSize(numChannels, capacityInSamples);
+        buffer.clear();
+        totalWritten.store(0);
+        writeEnd.store(0);
+    }
+
+    //Audio thread only. Pushes the first numSamples of source. Mono (or narrower) inputs are copied into every ring channel.
+    void push(const juce::AudioBuffer<float>& source, int numInputChannels, int numSamples)
+    {
+        const int capacity = buffer.getNumSamples();
+
+        if (capacity == 0 || numSamples == 0)
+            return;
+
+        const auto written = totalWritten.load(std::memory_order_relaxed);
+
+        //A block longer than the ring only keeps its newest samples.
+        const int sourceOffset = juce::jmax(0, numSamples - capacity);
+        const int numToCopy = numSamples - sourceOffset;
+        const int start = (int)((written + sourceOffset) % capacity);
+        const int size1 = juce::jmin(numToCopy, capacity - start);
+        const int size2 = numToCopy - size1;
+
+        //Announced before any sample is touched, so a reader can tell the block may have reached its range.
+        writeEnd.store(written + numSamples, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* dest = buffer.getWritePointer(channel);
+
+            if (numInputChannels <= 0)
+            {
+                juce::FloatVectorOperations::clear(dest + start, size1);
+                juce::FloatVectorOperations::clear(dest, size2);
+                continue;
+            }
+
+            const auto* src = source.getReadPointer(juce::jmin(channel, numInputChannels - 1), sourceOffset);
+            juce::FloatVectorOperations::copy(dest + start, src, size1);
+            juce::FloatVectorOperations::copy(dest, src + size1, size2);
+        }
+
+        totalWritten.store(written + numSamples, std::memory_order_release);
+    }
+
+    //Absolute position (in samples since prepare) one past the newest sample.
+    juce::int64 getTotalWritten() const
+    {
+        return totalWritten.load(std::memory_order_acquire);
+    }
+
+    int getCapacity() const
+    {
+        return buffer.getNumSamples();
+    }
+
+    int getNumChannels() const
+    {
+        return buffer.getNumChannels();
+    }
+
+    //Copies [startPosition, startPosition + numSamples) into dest, starting at sample 0.
+    //Returns false if the range is not written yet or the writer overwrote part of it
+    //while it was being copied.
+    bool copyRange(juce::AudioBuffer<float>& dest, juce::int64 startPosition, int numSamples) const
+    {
+        const int capacity = buffer.getNumSamples();
+        const auto endBefore = getTotalWritten();
+
+        if (startPosition < 0
+            || numSamples > capacity
+            || numSamples > dest.getNumSamples()
+            || startPosition + numSamples > endBefore
+            || endBefore - startPosition > capacity)
+            return false;
+
+        const int start = (int)(startPosition % capacity);
+        const int size1 = juce::jmin(numSamples, capacity - start);
+        const int size2 = numSamples - size1;
+
+        for (int channel = 0; channel < dest.getNumChannels(); ++channel)
+        {
+            const auto* src = buffer.getReadPointer(juce::jmin(channel, buffer.getNumChannels() - 1));
+            auto* out = dest.getWritePointer(channel);
+            juce::FloatVectorOperations::copy(out, src + start, size1);
+            juce::FloatVectorOperations::copy(out + size1, src, size2);
+        }
+
+        //Anything older than (end - capacity) may have been overwritten during the copy. The end includes
+        //a block still being written, totalWritten only counts it once it is complete.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return writeEnd.load(std::memory_order_relaxed) - capacity <= startPosition;
+    }
+
+private:
+    juce::AudioBuffer<float> buffer;
+    std::atomic<juce::int64> totalWritten{ 0 };
+
+    //End of the block being written, or of the last one. Ahead of totalWritten while push() copies.
+    std::atomic<juce::int64> writeEnd{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(CaptureRingBuffer)
+};
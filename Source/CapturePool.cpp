@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    CapturePool.cpp
+    Created: 25 Oct 2026 9:41:27am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "CapturePool.h"
+
+static_assert(capture::poolBlockSamples % (int)(PlanarBuffer::planarAlignment / sizeof(float)) == 0,
+              "Pool blocks must be whole cache lines for the budget to be exact");
+
+CapturePool::CapturePool()
+    : budgetBytes(chooseBudget())
+{
+}
+
+size_t CapturePool::chooseBudget()
+{
+    const int fromEnvironment = juce::SystemStats::getEnvironmentVariable(capture::poolBudgetVariable, {}).getIntValue();
+    const int megabytes = fromEnvironment > 0 ? fromEnvironment : capture::poolBudgetMB;
+
+    return (size_t)megabytes * 1024 * 1024;
+}
+
+void CapturePool::setBudget(size_t bytes)
+{
+    juce::OwnedArray<PlanarBuffer> dropped;
+
+    const juce::ScopedLock sl(lock);
+    budgetBytes = bytes;
+
+    while (! idle.isEmpty() && leasedBytes + idleBytes > budgetBytes)
+    {
+        idleBytes -= idle.getLast()->getSizeInBytes();
+        dropped.add(idle.removeAndReturn(idle.size() - 1));
+    }
+}
+
+CapturePool::Stats CapturePool::getStats() const
+{
+    const juce::ScopedLock sl(lock);
+    return { budgetBytes, leasedBytes, idleBytes, numLeased, idle.size() };
+}
+
+CapturePool::Lease CapturePool::checkout(int numChannels, int numSamples)
+{
+    //Whole blocks, so the next window of about the same length fits the same buffer.
+    const int blockSamples = (numSamples + capture::poolBlockSamples - 1) / capture::poolBlockSamples * capture::poolBlockSamples;
+    juce::OwnedArray<PlanarBuffer> dropped;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        //Smallest kept buffer that holds the window.
+        PlanarBuffer* best = nullptr;
+
+        for (auto* buffer : idle)
+            if (buffer->getNumChannels() == numChannels && buffer->getMaxNumSamples() >= numSamples
+                && (best == nullptr || buffer->getSizeInBytes() < best->getSizeInBytes()))
+                best = buffer;
+
+        if (best != nullptr)
+        {
+            idle.removeObject(best, false);
+            idleBytes -= best->getSizeInBytes();
+            leasedBytes += best->getSizeInBytes();
+            ++numLeased;
+            return makeLease(best, numSamples);
+        }
+
+        //Whole blocks are whole cache lines, so this is what PlanarBuffer allocates, less its alignment slack.
+        const size_t bytes = (size_t)numChannels * (size_t)blockSamples * sizeof(float);
+
+        while (! idle.isEmpty() && leasedBytes + idleBytes + bytes > budgetBytes)
+        {
+            idleBytes -= idle.getLast()->getSizeInBytes();
+            dropped.add(idle.removeAndReturn(idle.size() - 1));
+        }
+
+        if (leasedBytes + idleBytes + bytes > budgetBytes && numLeased > 0)
+            return {};
+
+        //Reserved now, the allocation itself happens outside the lock.
+        leasedBytes += bytes;
+        ++numLeased;
+    }
+
+    auto* buffer = new PlanarBuffer();
+    buffer->allocate(numChannels, blockSamples);
+    return makeLease(buffer, numSamples);
+}
+
+CapturePool::Lease CapturePool::makeLease(PlanarBuffer* buffer, int numSamples)
+{
+    buffer->setNumSamples(numSamples);
+
+    //The deleter holds on to the pool, so a lease may outlive the instance that took it.
+    return Lease(buffer, [pool = juce::SharedResourcePointer<CapturePool>()](PlanarBuffer* leased)
+        {
+            pool->giveBack(leased);
+        });
+}
+
+void CapturePool::giveBack(PlanarBuffer* buffer)
+{
+    std::unique_ptr<PlanarBuffer> dropped;
+
+    {
+        const juce::ScopedLock sl(lock);
+        const auto bytes = buffer->getSizeInBytes();
+
+        leasedBytes -= bytes;
+        --numLeased;
+
+        if (idle.size() < capture::poolMaxIdleBuffers && leasedBytes + idleBytes + bytes <= budgetBytes)
+        {
+            idle.add(buffer);
+            idleBytes += bytes;
+        }
+        else
+        {
+            dropped.reset(buffer);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    CapturePool.h
+    Created: 25 Oct 2026 9:41:27am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+#include "PlanarBuffer.h"
+
+//==============================================================================
+/**
+    Analysis window buffers shared by every instance through a
+    SharedResourcePointer.
+
+    An instance checks a buffer out when an evaluation starts, copies its
+    window into it and hands it to the workers, so an idle instance holds no
+    window memory and its ring can take the next capture at once. The buffer
+    goes back when the last Lease to it is released.
+
+    Leased and kept buffers together stay within the budget
+    (capture::poolBudgetMB). A checkout that does not fit first drops kept
+    buffers and otherwise fails at once, it never waits: the leases it would
+    wait for are often held by queued jobs that need a worker to finish. A
+    window is always granted when nothing else is leased, however large. Any
+    thread except the audio thread.
+*/
+class CapturePool
+{
+public:
+    using Lease = std::shared_ptr<PlanarBuffer>;
+
+    struct Stats
+    {
+        size_t budgetBytes = 0;
+        size_t leasedBytes = 0;
+        size_t idleBytes = 0;
+        int numLeased = 0;
+        int numIdle = 0;
+    };
+
+    CapturePool();
+
+    //A buffer of numChannels x numSamples, its view set to numSamples. Empty if it does not fit the budget.
+    Lease checkout(int numChannels, int numSamples);
+
+    void setBudget(size_t bytes);
+    Stats getStats() const;
+
+private:
+    void giveBack(PlanarBuffer* buffer);
+    Lease makeLease(PlanarBuffer* buffer, int numSamples);
+
+    static size_t chooseBudget();
+
+    mutable juce::CriticalSection lock;
+
+    juce::OwnedArray<PlanarBuffer> idle;
+    size_t budgetBytes;
+    size_t leasedBytes = 0;
+    size_t idleBytes = 0;
+    int numLeased = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CapturePool)
+};
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    ChannelPairs.cpp
+    Created: 21 Oct 2026 9:34:52am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ChannelPairs.h"
+
+namespace
+{
+    using ChannelType = juce::AudioChannelSet::ChannelType;
+
+    //Left channel type and its right counterpart.
+    static constexpr std::pair<ChannelType, ChannelType> counterparts[] = {
+        { juce::AudioChannelSet::left,              juce::AudioChannelSet::right },
+        { juce::AudioChannelSet::leftCentre,        juce::AudioChannelSet::rightCentre },
+        { juce::AudioChannelSet::leftSurround,      juce::AudioChannelSet::rightSurround },
+        { juce::AudioChannelSet::leftSurroundSide,  juce::AudioChannelSet::rightSurroundSide },
+        { juce::AudioChannelSet::leftSurroundRear,  juce::AudioChannelSet::rightSurroundRear },
+        { juce::AudioChannelSet::wideLeft,          juce::AudioChannelSet::wideRight },
+        { juce::AudioChannelSet::topFrontLeft,      juce::AudioChannelSet::topFrontRight },
+        { juce::AudioChannelSet::topSideLeft,       juce::AudioChannelSet::topSideRight },
+        { juce::AudioChannelSet::topRearLeft,       juce::AudioChannelSet::topRearRight },
+        { juce::AudioChannelSet::bottomFrontLeft,   juce::AudioChannelSet::bottomFrontRight }
+    };
+
+    bool isLfe(ChannelType type)
+    {
+        return type == juce::AudioChannelSet::LFE || type == juce::AudioChannelSet::LFE2;
+    }
+}
+
+juce::Array<ChannelPair> channelpairs::fromLayout(const juce::AudioChannelSet& layout)
+{
+    juce::Array<ChannelPair> pairs;
+    const int numChannels = layout.size();
+
+    if (layout.isDiscreteLayout() || numChannels <= 1)
+    {
+        for (int channel = 0; channel < numChannels; channel += 2)
+        {
+            const int right = juce::jmin(channel + 1, numChannels - 1);
+            pairs.add({ channel, right, right == channel ? juce::String(channel + 1) : juce::String(channel + 1) + "/" + juce::String(right + 1) });
+        }
+
+        return pairs;
+    }
+
+    juce::Array<int> used;
+
+    for (const auto& counterpart : counterparts)
+    {
+        const int left = layout.getChannelIndexForType(counterpart.first);
+        const int right = layout.getChannelIndexForType(counterpart.second);
+
+        if (left >= 0 && right >= 0)
+        {
+            pairs.add({ left, right, juce::AudioChannelSet::getAbbreviatedChannelTypeName(counterpart.first) + "/"
+                                   + juce::AudioChannelSet::getAbbreviatedChannelTypeName(counterpart.second) });
+            used.add(left);
+            used.add(right);
+        }
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        const auto type = layout.getTypeOfChannel(channel);
+
+        if (! used.contains(channel) && ! isLfe(type))
+            pairs.add({ channel, channel, juce::AudioChannelSet::getAbbreviatedChannelTypeName(type) });
+    }
+
+    return pairs;
+}
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    ChannelPairs.h
+    Created: 21 Oct 2026 9:34:52am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//Two channels of a bus analysed together. left == right for a single channel.
+struct ChannelPair
+{
+    int left = 0;
+    int right = 0;
+
+    //"L/R", "C", "3/4", ...
+    juce::String name;
+
+    //Analysed as dual mono, which always reads as fully correlated with no delay modulation.
+    bool isSingle() const noexcept { return left == right; }
+};
+
+namespace channelpairs
+{
+    //Splits a bus layout into the channel pairs the detector analyses.
+    //
+    //Named layouts pair each left channel with its right counterpart (L/R, Ls/Rs,
+    //Ltf/Rtf and so on). Channels without a counterpart, such as the centre, are
+    //analysed on their own, but only count towards the result of a layout that
+    //has no real pair (see ChannelPair::isSingle()). LFE channels carry nothing a chorus detector can use
+    //and are skipped. Discrete layouts are paired in order: 1/2, 3/4, ...
+    juce::Array<ChannelPair> fromLayout(const juce::AudioChannelSet& layout);
+}
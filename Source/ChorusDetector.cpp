@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    ChorusDetector.cpp
+    Created: 17 Oct 2026 11:20:41am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ChorusDetector.h"
+#include "AnalysisKernels.h"
+
+namespace
+{
+    //Analysis grid
+    constexpr double targetRate = 12000.0;
+    constexpr double frameSeconds = 0.04;
+    constexpr double hopSeconds = 0.01;
+
+    //Search ranges
+    constexpr double maxDelayMs = 5.0;
+    constexpr double minPitchHz = 80.0;
+    constexpr double maxPitchHz = 800.0;
+    constexpr float voicingThreshold = 0.6f;
+    constexpr float silenceMeanSquare = 1.0e-7f;
+
+    //LFO band of the modulation trackers
+    constexpr double lfoLowHz = 0.2;
+    constexpr double lfoHighHz = 8.0;
+    constexpr double warmUpSeconds = 0.05;
+
+    //Steps larger than these are note changes or lag flips, not modulation.
+    constexpr float maxDelayStepMs = 1.5f;
+    constexpr float maxPitchStepCents = 80.0f;
+
+    //Heuristic mapping of the features to 0-1.
+    constexpr float scoreBias = -4.0f;
+    constexpr float weightDelayMs = 6.0f;
+    constexpr float weightPitchCents = 0.15f;
+    constexpr float weightDecorrelation = 5.0f;
+
+    //Offset of the true peak from the middle of three samples.
+    float parabolicOffset(float before, float peak, float after)
+    {
+        const float denominator = before - 2.0f * peak + after;
+
+        if (std::abs(denominator) < 1.0e-12f)
+            return 0.0f;
+
+        return juce::jlimit(-0.5f, 0.5f, 0.5f * (before - after) / denominator);
+    }
+
+    //Plain running mean until count reaches memory, exponential after that.
+    void updateMean(double& mean, double value, int& count, int memory)
+    {
+        if (memory <= 0 || count < memory)
+            ++count;
+
+        mean += (value - mean) / count;
+    }
+}
+
+//==============================================================================
+void ChorusDetector::ModulationTracker::setup(double hopRate, float maxStepSize, int memory)
+{
+    lowCoeff = (float)std::exp(-juce::MathConstants<double>::twoPi * lfoHighHz / hopRate);
+    highCoeff = (float)std::exp(-juce::MathConstants<double>::twoPi * lfoLowHz / hopRate);
+    warmUpHops = juce::jmax(1, juce::roundToInt(warmUpSeconds * hopRate));
+    maxStep = maxStepSize;
+    memoryHops = memory;
+    reset();
+}
+
+void ChorusDetector::ModulationTracker::reset()
+{
+    restart();
+    meanSquare = 0.0;
+    count = 0;
+}
+
+void ChorusDetector::ModulationTracker::restart()
+{
+    warmUp = -1;
+}
+
+void ChorusDetector::ModulationTracker::push(float value)
+{
+    if (warmUp >= 0 && std::abs(value - lastValue) > maxStep)
+        restart();
+
+    lastValue = value;
+
+    if (warmUp < 0)
+    {
+        lowState = value;
+        highState = value;
+        warmUp = 0;
+    }
+
+    lowState = value + lowCoeff * (lowState - value);
+    highState = value + highCoeff * (highState - value);
+
+    if (warmUp < warmUpHops)
+    {
+        ++warmUp;
+        return;
+    }
+
+    const float band = lowState - highState;
+    updateMean(meanSquare, band * band, count, memoryHops);
+}
+
+float ChorusDetector::ModulationTracker::getDepth() const
+{
+    return count > 0 ? (float)std::sqrt(meanSquare) : 0.0f;
+}
+
+//==============================================================================
+void ChorusDetector::prepare(double sampleRate)
+{
+    decimation = juce::jmax(1, juce::roundToInt(sampleRate / targetRate));
+    analysisRate = sampleRate / decimation;
+
+    frameSize = juce::roundToInt(frameSeconds * analysisRate);
+    hopSize = juce::jmax(1, juce::roundToInt(hopSeconds * analysisRate));
+    maxDelayLag = juce::roundToInt(maxDelayMs * 0.001 * analysisRate);
+    minPitchLag = juce::jmax(2, (int)std::floor(analysisRate / maxPitchHz));
+    maxPitchLag = juce::jmin(frameSize / 2, (int)std::ceil(analysisRate / minPitchHz));
+
+    history.setSize(2, frameSize);
+    frame.setSize(3, frameSize);
+    lagScratch.allocate((size_t)juce::jmax(2 * maxDelayLag + 1, maxPitchLag - minPitchLag + 3), true);
+
+    setMemorySeconds(memorySeconds);
+}
+
+void ChorusDetector::setMemorySeconds(double seconds)
+{
+    memorySeconds = seconds;
+
+    if (hopSize == 0)
+        return;
+
+    const double hopRate = analysisRate / hopSize;
+    memoryHops = juce::roundToInt(memorySeconds * hopRate);
+    delayTracker.setup(hopRate, maxDelayStepMs, memoryHops);
+    pitchTracker.setup(hopRate, maxPitchStepCents, memoryHops);
+
+    reset();
+}
+
+void ChorusDetector::reset()
+{
+    decimSumL = 0.0f;
+    decimSumR = 0.0f;
+    decimCount = 0;
+
+    history.clear();
+    historyWrite = 0;
+    samplesSinceHop = 0;
+    samplesSeen = 0;
+
+    delayTracker.reset();
+    pitchTracker.reset();
+    meanDecorrelation = 0.0;
+    numFrames = 0;
+}
+
+void ChorusDetector::pushSamples(const float* left, const float* right, int numSamples)
+{
+    if (frameSize == 0)
+        return;
+
+    auto* historyL = history.getWritePointer(0);
+    auto* historyR = history.getWritePointer(1);
+    const float gain = 1.0f / decimation;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        //Box-filter decimation down to the analysis rate.
+        decimSumL += left[i];
+        decimSumR += right[i];
+
+        if (++decimCount < decimation)
+            continue;
+
+        historyL[historyWrite] = decimSumL * gain;
+        historyR[historyWrite] = decimSumR * gain;
+        decimSumL = 0.0f;
+        decimSumR = 0.0f;
+        decimCount = 0;
+
+        historyWrite = (historyWrite + 1) % frameSize;
+        samplesSeen = juce::jmin(samplesSeen + 1, frameSize);
+
+        if (++samplesSinceHop >= hopSize && samplesSeen == frameSize)
+        {
+            samplesSinceHop = 0;
+            processFrame();
+        }
+    }
+}
+
+void ChorusDetector::processFrame()
+{
+    //Unwrap the history, oldest sample first.
+    const int tail = frameSize - historyWrite;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const auto* src = history.getReadPointer(channel);
+        auto* dest = frame.getWritePointer(channel);
+        juce::FloatVectorOperations::copy(dest, src + historyWrite, tail);
+        juce::FloatVectorOperations::copy(dest + tail, src, historyWrite);
+    }
+
+    auto* mid = frame.getWritePointer(2);
+    juce::FloatVectorOperations::add(mid, frame.getReadPointer(0), frame.getReadPointer(1), frameSize);
+    juce::FloatVectorOperations::multiply(mid, 0.5f, frameSize);
+
+    float delayMs = 0.0f;
+    float correlation = 0.0f;
+
+    if (! measureDelay(delayMs, correlation))
+    {
+        //Silence breaks both trajectories.
+        delayTracker.restart();
+        pitchTracker.restart();
+        return;
+    }
+
+    updateMean(meanDecorrelation, 1.0f - juce::jmax(0.0f, correlation), numFrames, memoryHops);
+
+    delayTracker.push(delayMs);
+
+    float cents = 0.0f;
+
+    if (measurePitch(cents))
+        pitchTracker.push(cents);
+    else
+        pitchTracker.restart();
+}
+
+bool ChorusDetector::measureDelay(float& delayMs, float& correlation) const
+{
+    const auto* left = frame.getReadPointer(0);
+    const auto* right = frame.getReadPointer(1);
+
+    const float energyL = kernels::sumOfSquares(left, frameSize);
+    const float energyR = kernels::sumOfSquares(right, frameSize);
+
+    if (energyL < silenceMeanSquare * frameSize || energyR < silenceMeanSquare * frameSize)
+        return false;
+
+    //lagScratch[maxDelayLag + k] holds the product at lag k.
+    auto* products = lagScratch.get();
+    kernels::crossCorrelation(left, right, frameSize, maxDelayLag, products);
+
+    int best = maxDelayLag;
+
+    for (int i = 0; i < 2 * maxDelayLag + 1; ++i)
+        if (products[i] > products[best])
+            best = i;
+
+    float offset = 0.0f;
+
+    if (best > 0 && best < 2 * maxDelayLag)
+        offset = parabolicOffset(products[best - 1], products[best], products[best + 1]);
+
+    delayMs = (float)((best - maxDelayLag + offset) * 1000.0 / analysisRate);
+    correlation = products[best] / std::sqrt(energyL * energyR);
+    return true;
+}
+
+bool ChorusDetector::measurePitch(float& cents) const
+{
+    const auto* mid = frame.getReadPointer(2);
+    const float energy = kernels::sumOfSquares(mid, frameSize);
+
+    if (energy < silenceMeanSquare * frameSize)
+        return false;
+
+    //One extra lag on each side for the interpolation.
+    const int firstLag = minPitchLag - 1;
+    const int numLags = maxPitchLag - minPitchLag + 3;
+    auto* values = lagScratch.get();
+    kernels::autocorrelation(mid, frameSize, firstLag, firstLag + numLags - 1, values);
+
+    //Scale up for the shrinking overlap.
+    for (int i = 0; i < numLags; ++i)
+    {
+        const int overlap = frameSize - (firstLag + i);
+        values[i] *= (float)frameSize / (overlap * energy);
+    }
+
+    //values[0] is only the interpolation guard, a bass-heavy frame makes it large.
+    int best = 0;
+    float bestValue = voicingThreshold;
+
+    for (int i = 1; i < numLags - 1; ++i)
+    {
+        if (values[i] > bestValue)
+        {
+            best = i;
+            bestValue = values[i];
+        }
+    }
+
+    if (best == 0)
+        return false;
+
+    const float period = firstLag + best + parabolicOffset(values[best - 1], values[best], values[best + 1]);
+    const double frequency = analysisRate / period;
+
+    cents = (float)(1200.0 * std::log2(frequency / 440.0));
+    return true;
+}
+
+float ChorusDetector::getChorusAmount() const
+{
+    if (! hasEstimate())
+        return 0.0f;
+
+    const auto features = getFeatures();
+
+    const float z = scoreBias
+                  + weightDelayMs * features.delayModulationMs
+                  + weightPitchCents * features.pitchModulationCents
+                  + weightDecorrelation * features.decorrelation;
+
+    return 1.0f / (1.0f + std::exp(-z));
+}
+
+bool ChorusDetector::hasEstimate() const
+{
+    return numFrames > 0;
+}
+
+ChorusDetector::Features ChorusDetector::getFeatures() const
+{
+    Features features;
+    features.delayModulationMs = delayTracker.getDepth();
+    features.pitchModulationCents = pitchTracker.getDepth();
+    features.decorrelation = (float)meanDecorrelation;
+    features.numFrames = numFrames;
+    return features;
+}
+
+float ChorusDetector::analyse(const juce::AudioBuffer<float>& buffer, double sampleRate)
+{
+    if (sampleRate != analysisRate * decimation || frameSize == 0)
+        prepare(sampleRate);
+
+    reset();
+
+    const auto* left = buffer.getReadPointer(0);
+    const auto* right = buffer.getReadPointer(juce::jmin(1, buffer.getNumChannels() - 1));
+    pushSamples(left, right, buffer.getNumSamples());
+
+    return getChorusAmount();
+}
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    ChorusDetector.h
+    Created: 17 Oct 2026 11:20:41am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    In-process chorus estimator.
+
+    Audio is reduced to roughly 12 kHz and cut into short overlapping frames.
+    For every hop the detector measures
+      - the L/R delay (peak of the inter-channel cross-correlation),
+      - the pitch of the mid signal (peak of its autocorrelation),
+      - how decorrelated the two channels are,
+    and tracks how strongly the delay and pitch trajectories move at LFO rates
+    (roughly 0.2 - 8 Hz). Ensembles and chorus effects wobble in both, a single
+    dry voice or instrument mostly does not.
+
+    All buffers are allocated in prepare(); pushSamples() and getChorusAmount()
+    do not allocate.
+*/
+class ChorusDetector
+{
+public:
+    //Bumped whenever a change moves the results, so cached results of the old detector are not reused.
+    static constexpr int version = 2;
+
+    ChorusDetector() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+
+    //How far back the statistics reach. 0 averages everything since reset(),
+    //which is what a one-shot analysis wants; streaming use sets a few seconds.
+    void setMemorySeconds(double seconds);
+
+    //Feeds new audio. Features are updated once for every completed hop.
+    void pushSamples(const float* left, const float* right, int numSamples);
+
+    //Current estimate in the 0-1 range of paramChorusAmount.
+    float getChorusAmount() const;
+
+    //False until at least one non-silent frame has been analysed.
+    bool hasEstimate() const;
+
+    //One-shot analysis of a whole capture window.
+    float analyse(const juce::AudioBuffer<float>& buffer, double sampleRate);
+
+    //Feature values behind the current estimate.
+    struct Features
+    {
+        float delayModulationMs = 0.0f;
+        float pitchModulationCents = 0.0f;
+        float decorrelation = 0.0f;
+        int numFrames = 0;
+    };
+
+    Features getFeatures() const;
+
+private:
+    //Band-pass at LFO rates followed by a running mean of the squared output.
+    struct ModulationTracker
+    {
+        void setup(double hopRate, float maxStepSize, int memory);
+        void reset();
+        void restart();
+        void push(float value);
+        float getDepth() const;
+
+        float lowCoeff = 0.0f;
+        float highCoeff = 0.0f;
+        float lowState = 0.0f;
+        float highState = 0.0f;
+        float lastValue = 0.0f;
+        float maxStep = 0.0f;
+        int warmUp = -1;
+        int warmUpHops = 0;
+        int memoryHops = 0;
+        double meanSquare = 0.0;
+        int count = 0;
+    };
+
+    void processFrame();
+    bool measureDelay(float& delayMs, float& correlation) const;
+    bool measurePitch(float& cents) const;
+
+    double analysisRate = 0.0;
+    double memorySeconds = 0.0;
+    int memoryHops = 0;
+    int decimation = 1;
+    int frameSize = 0;
+    int hopSize = 0;
+    int maxDelayLag = 0;
+    int minPitchLag = 0;
+    int maxPitchLag = 0;
+
+    //Decimator state
+    float decimSumL = 0.0f;
+    float decimSumR = 0.0f;
+    int decimCount = 0;
+
+    //Circular frame history at the analysis rate
+    juce::AudioBuffer<float> history;
+    int historyWrite = 0;
+    int samplesSinceHop = 0;
+    int samplesSeen = 0;
+
+    //Linearised frame scratch: left, right, mid
+    juce::AudioBuffer<float> frame;
+
+    //Correlation values per lag
+    juce::HeapBlock<float> lagScratch;
+
+    ModulationTracker delayTracker;
+    ModulationTracker pitchTracker;
+    double meanDecorrelation = 0.0;
+    int numFrames = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChorusDetector)
+};
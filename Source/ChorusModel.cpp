@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    ChorusModel.cpp
+    Created: 22 Oct 2026 9:20:37am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ChorusModel.h"
+#include "Config.h"
+
+namespace
+{
+    //File header, bumped when the layout changes.
+    static constexpr int fileMagic = 0x4C4D4643; // "CFML"
+    static constexpr int fileVersion = 1;
+
+    //Sanity limits, a damaged file must not turn into a huge allocation.
+    static constexpr int maxLayers = 64;
+    static constexpr int maxLayerSize = 4096;
+    static constexpr int maxKernelSize = 64;
+
+    bool readFloats(juce::InputStream& stream, juce::HeapBlock<float>& dest, int count)
+    {
+        if (stream.getNumBytesRemaining() < (juce::int64)count * 4)
+            return false;
+
+        dest.allocate((size_t)count, false);
+
+        for (int i = 0; i < count; ++i)
+            dest[i] = stream.readFloat();
+
+        return true;
+    }
+}
+
+ChorusModel::ChorusModel()
+{
+    const auto path = juce::SystemStats::getEnvironmentVariable(model::fileVariable, {});
+    const auto file = juce::File::isAbsolutePath(path) ? juce::File(path) : getDefaultFile();
+
+    status = load(file);
+}
+
+juce::File ChorusModel::getDefaultFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile(model::fileName);
+}
+
+juce::Result ChorusModel::load(const juce::File& file)
+{
+    juce::MemoryBlock data;
+
+    if (! file.loadFileAsData(data))
+        return juce::Result::fail("Cannot open " + file.getFullPathName());
+
+    juce::MemoryInputStream stream(data, false);
+    const auto result = loadFrom(stream);
+
+    //FNV-1a over the whole file.
+    identity = 14695981039346656037ull;
+
+    for (size_t i = 0; i < data.getSize(); ++i)
+    {
+        identity ^= (juce::uint8)data[i];
+        identity *= 1099511628211ull;
+    }
+
+    return result;
+}
+
+juce::Result ChorusModel::loadFrom(juce::InputStream& stream)
+{
+    layers.clear();
+
+    if (stream.readInt() != fileMagic || stream.readInt() != fileVersion)
+        return juce::Result::fail("Not a chorus model file, or a newer version");
+
+    frontEnd.numMels = stream.readInt();
+    frontEnd.minHz = stream.readFloat();
+    frontEnd.maxHz = stream.readFloat();
+    frontEnd.fftSize = stream.readInt();
+    frontEnd.hopSeconds = stream.readFloat();
+
+    if (frontEnd.numMels < 1 || frontEnd.numMels > 256 || frontEnd.fftSize < 64 || frontEnd.fftSize > 8192
+        || ! juce::isPowerOfTwo(frontEnd.fftSize) || frontEnd.hopSeconds <= 0.0f || frontEnd.maxHz <= frontEnd.minHz)
+        return juce::Result::fail("Invalid front end settings");
+
+    if (stream.readInt() != getNumFeatures()
+        || ! readFloats(stream, featureMean, getNumFeatures())
+        || ! readFloats(stream, featureScale, getNumFeatures()))
+        return juce::Result::fail("Invalid feature normalisation");
+
+    const int numLayers = stream.readInt();
+
+    if (numLayers < 1 || numLayers > maxLayers)
+        return juce::Result::fail("Invalid number of layers");
+
+    juce::OwnedArray<Layer> loaded;
+
+    //Shapes are checked as the file is read: frames x features in, one value out.
+    int width = getNumFeatures();
+    bool pooled = false;
+
+    for (int i = 0; i < numLayers; ++i)
+    {
+        auto* layer = loaded.add(new Layer());
+        layer->type = (LayerType)stream.readInt();
+        layer->numInputs = width;
+        layer->numOutputs = width;
+
+        switch (layer->type)
+        {
+        case LayerType::conv1d:
+        case LayerType::dense:
+        {
+            layer->numInputs = stream.readInt();
+            layer->numOutputs = stream.readInt();
+            layer->kernelSize = layer->type == LayerType::conv1d ? stream.readInt() : 1;
+
+            if (layer->numInputs != width || layer->numOutputs < 1 || layer->numOutputs > maxLayerSize
+                || layer->kernelSize < 1 || layer->kernelSize > maxKernelSize || (pooled && layer->kernelSize > 1))
+                return juce::Result::fail("Layer " + juce::String(i) + " does not fit the one before it");
+
+            if (! readFloats(stream, layer->weights, layer->numOutputs * layer->kernelSize * layer->numInputs)
+                || ! readFloats(stream, layer->bias, layer->numOutputs))
+                return juce::Result::fail("Layer " + juce::String(i) + " is truncated");
+
+            width = layer->numOutputs;
+            break;
+        }
+
+        case LayerType::meanPool:
+            pooled = true;
+            break;
+
+        case LayerType::relu:
+        case LayerType::sigmoid:
+            break;
+
+        default:
+            return juce::Result::fail("Unknown layer type in layer " + juce::String(i));
+        }
+    }
+
+    if (! pooled || width != 1)
+        return juce::Result::fail("The model must pool over time and end in a single output");
+
+    layers.swapWith(loaded);
+    return juce::Result::ok();
+}
+
+int ChorusModel::getMinFrames() const noexcept
+{
+    int frames = 1;
+
+    for (auto* layer : layers)
+        if (layer->type == LayerType::conv1d)
+            frames += layer->kernelSize - 1;
+
+    return frames;
+}
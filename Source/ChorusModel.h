@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    ChorusModel.h
+    Created: 22 Oct 2026 9:20:37am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Weights of the chorus classifier, as written by Tools/chorus_model.py.
+
+    The network reads log-mel frames (mid bands, then side bands) and is a
+    plain stack of layers: 1-D convolutions over time, dense layers applied to
+    every frame, ReLU, a mean over time and a final sigmoid. The last layer
+    must leave one value, the 0-1 chorus amount.
+
+    File layout, little-endian:
+        int magic "CFML", int version
+        int numMels, float minHz, float maxHz, int fftSize, float hopSeconds
+        int numFeatures, float mean[numFeatures], float scale[numFeatures]
+        int numLayers, then per layer: int type and its parameters
+            conv1d   int in, int out, int kernel, float weights[out][kernel][in], float bias[out]
+            dense    int in, int out, float weights[out][in], float bias[out]
+            relu, meanPool, sigmoid have none
+
+    One model per process, shared by every instance through a
+    SharedResourcePointer. It loads model::fileVariable, or model::fileName in
+    the user's application data folder, and is read-only afterwards, so any
+    number of ModelRunners can use it at once.
+*/
+class ChorusModel
+{
+public:
+    enum class LayerType
+    {
+        conv1d,
+        dense,
+        relu,
+        meanPool,
+        sigmoid
+    };
+
+    struct Layer
+    {
+        LayerType type = LayerType::relu;
+        int numInputs = 0;
+        int numOutputs = 0;
+        int kernelSize = 1;
+        juce::HeapBlock<float> weights;
+        juce::HeapBlock<float> bias;
+    };
+
+    struct FrontEnd
+    {
+        int numMels = 0;
+        float minHz = 0.0f;
+        float maxHz = 0.0f;
+        int fftSize = 0;
+        float hopSeconds = 0.0f;
+    };
+
+    ChorusModel();
+
+    //Replaces the current model. Not while a ModelRunner uses it.
+    juce::Result loadFrom(juce::InputStream& stream);
+    juce::Result load(const juce::File& file);
+
+    bool isLoaded() const noexcept { return ! layers.isEmpty(); }
+
+    //Hash of the loaded file, so results of another model are not taken from the cache.
+    juce::uint64 getIdentity() const noexcept { return identity; }
+
+    //Why the default model did not load.
+    const juce::Result& getStatus() const noexcept { return status; }
+
+    const FrontEnd& getFrontEnd() const noexcept { return frontEnd; }
+    int getNumFeatures() const noexcept { return 2 * frontEnd.numMels; }
+    const float* getFeatureMean() const noexcept { return featureMean.get(); }
+    const float* getFeatureScale() const noexcept { return featureScale.get(); }
+    const juce::OwnedArray<Layer>& getLayers() const noexcept { return layers; }
+
+    //Fewest frames the convolutions need to produce one output frame.
+    int getMinFrames() const noexcept;
+
+    static juce::File getDefaultFile();
+
+private:
+    FrontEnd frontEnd;
+    juce::HeapBlock<float> featureMean;
+    juce::HeapBlock<float> featureScale;
+    juce::OwnedArray<Layer> layers;
+    juce::Result status = juce::Result::ok();
+    juce::uint64 identity = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChorusModel)
+};
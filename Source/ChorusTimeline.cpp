@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    ChorusTimeline.cpp
+    Created: 18 Oct 2026 8:03:21pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ChorusTimeline.h"
+
+void ChorusTimeline::clear(double startSeconds, double hopSeconds, double windowSeconds)
+{
+    const juce::ScopedLock wl(writeLock);
+    const juce::SpinLock::ScopedLockType sl(lock);
+
+    data.startSeconds = startSeconds;
+    data.hopSeconds = hopSeconds;
+    data.windowSeconds = windowSeconds;
+    data.chorus.clearQuick();
+    numHops = 0;
+}
+
+void ChorusTimeline::reserve(int newNumHops)
+{
+    const juce::ScopedLock wl(writeLock);
+
+    juce::Array<float> grown;
+
+    if (newNumHops > data.chorus.size())
+    {
+        //Grown by doubling outside the spin lock, the audio thread only ever waits for the swap.
+        const int capacity = juce::jmax(newNumHops, 2 * data.chorus.size(), 64);
+        grown.ensureStorageAllocated(capacity);
+        grown.addArray(data.chorus);
+
+        while (grown.size() < capacity)
+            grown.add(std::numeric_limits<float>::quiet_NaN());
+    }
+
+    const juce::SpinLock::ScopedLockType sl(lock);
+
+    if (! grown.isEmpty())
+        data.chorus.swapWith(grown);
+
+    numHops = juce::jmax(numHops, newNumHops);
+}
+
+void ChorusTimeline::set(int hop, float chorus)
+{
+    if (hop < 0)
+        return;
+
+    const juce::ScopedLock wl(writeLock);
+
+    //Only grows here if nobody reserved the hop.
+    if (hop >= numHops)
+        reserve(hop + 1);
+
+    const juce::SpinLock::ScopedLockType sl(lock);
+    data.chorus.setUnchecked(hop, chorus);
+}
+
+void ChorusTimeline::setData(const Data& newData)
+{
+    const juce::ScopedLock wl(writeLock);
+
+    //Copied outside the spin lock, the old storage is freed outside it too.
+    auto copy = newData;
+
+    {
+        const juce::SpinLock::ScopedLockType sl(lock);
+        std::swap(data, copy);
+        numHops = data.chorus.size();
+    }
+}
+
+ChorusTimeline::Data ChorusTimeline::getData() const
+{
+    //Writers are shut out by writeLock, and the audio thread only reads.
+    const juce::ScopedLock wl(writeLock);
+
+    auto copy = data;
+    copy.chorus.resize(numHops);
+    return copy;
+}
+
+int ChorusTimeline::getNumHops() const
+{
+    const juce::ScopedLock wl(writeLock);
+    return numHops;
+}
+
+bool ChorusTimeline::tryGetValueAt(double seconds, float& chorus) const noexcept
+{
+    const juce::SpinLock::ScopedTryLockType tl(lock);
+
+    if (! tl.isLocked() || data.hopSeconds <= 0.0)
+        return false;
+
+    const int hop = juce::roundToInt((seconds - data.startSeconds - 0.5 * data.windowSeconds) / data.hopSeconds);
+
+    if (! juce::isPositiveAndBelow(hop, numHops))
+        return false;
+
+    const float value = data.chorus.getUnchecked(hop);
+
+    if (std::isnan(value))
+        return false;
+
+    chorus = value;
+    return true;
+}
+
+bool ChorusTimeline::exportCsv(const juce::File& file) const
+{
+    const auto snapshot = getData();
+
+    juce::String csv;
+    csv << "time,chorus,solo" << juce::newLine;
+
+    for (int i = 0; i < snapshot.chorus.size(); ++i)
+    {
+        const float chorus = snapshot.chorus.getUnchecked(i);
+
+        if (std::isnan(chorus))
+            continue;
+
+        const double time = snapshot.startSeconds + i * snapshot.hopSeconds;
+        csv << juce::String(time, 3) << "," << juce::String(chorus, 4) << "," << juce::String(1.0f - chorus, 4) << juce::newLine;
+    }
+
+    return file.replaceWithText(csv);
+}
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    ChorusTimeline.h
+    Created: 18 Oct 2026 8:03:21pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Whole-track chorus amounts, one float per hop.
+
+    Value i describes the window that starts at startSeconds + i * hopSeconds
+    and lasts windowSeconds, in host time. Hops that have not been analysed yet
+    hold NaN. The solo amount of a hop is 1 - chorus, as in the editor.
+
+    Writers are worker threads, the audio thread only reads through
+    tryGetValueAt(), which never blocks. Writers and copies are serialised by
+    a CriticalSection the audio thread never touches. The SpinLock it tries
+    is only held to write one value or to swap in storage that was grown
+    outside it, so a failed try is rare and brief.
+*/
+class ChorusTimeline
+{
+public:
+    struct Data
+    {
+        double startSeconds = 0.0;
+        double hopSeconds = 0.0;
+        double windowSeconds = 0.0;
+        juce::Array<float> chorus;
+    };
+
+    ChorusTimeline() = default;
+
+    //Any thread except the audio thread.
+    void clear(double startSeconds, double hopSeconds, double windowSeconds);
+
+    //Makes room for hops [0, numHops), unanalysed. Called before the hops are analysed,
+    //so set() only writes a value.
+    void reserve(int numHops);
+    void set(int hop, float chorus);
+    void setData(const Data& newData);
+    Data getData() const;
+    int getNumHops() const;
+
+    //Audio thread. Value of the window centred closest to the given host time.
+    //False if it has not been analysed, lies outside the timeline or a writer holds the lock.
+    bool tryGetValueAt(double seconds, float& chorus) const noexcept;
+
+    //time (s), chorus, solo - one line per analysed hop.
+    bool exportCsv(const juce::File& file) const;
+
+private:
+    //Held by every call except tryGetValueAt().
+    mutable juce::CriticalSection writeLock;
+
+    //Held while data changes, tried by the audio thread.
+    mutable juce::SpinLock lock;
+
+    //chorus may be allocated past numHops, the extra hops are NaN.
+    Data data;
+    int numHops = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChorusTimeline)
+};
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    ChunkedUploader.cpp
+    Created: 17 Oct 2026 6:15:09pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ChunkedUploader.h"
+#include "Config.h"
+
+void ChunkedUploader::prepare(int numChannels, double sampleRate)
+{
+    bufChunk.setSize(numChannels, (int)std::ceil(upload::chunkSeconds * sampleRate));
+}
+
+bool ChunkedUploader::run(const juce::String& chunkUrl, const CaptureRingBuffer& ring, juce::int64 startPosition, juce::int64 endPosition,
+                          double sampleRate, int format, const std::function<bool()>& shouldAbort, float& result)
+{
+    lastStatusCode = 0;
+    acceptedFormats.clear();
+
+    const auto session = juce::Uuid().toDashedString();
+    const int chunkSamples = bufChunk.getNumSamples();
+    auto position = startPosition;
+    int sequence = 0;
+
+    while (position < endPosition)
+    {
+        const int numSamples = (int)juce::jmin((juce::int64)chunkSamples, endPosition - position);
+
+        //Wait for the audio thread to record the next chunk.
+        if (ring.getTotalWritten() < position + numSamples)
+        {
+            if (shouldAbort != nullptr && shouldAbort())
+                return false;
+
+            juce::Thread::sleep(upload::pollIntervalMs);
+            continue;
+        }
+
+        if (! ring.copyRange(bufChunk, position, numSamples))
+        {
+            logger->log(AsyncLogger::Level::warning, "Chunked upload fell behind the capture ring.");
+            return false;
+        }
+
+        if (! encoder.encode(bufChunk, numSamples, sampleRate, format, analysis::uploadMidOnly))
+            return false;
+
+        if (shouldAbort != nullptr && shouldAbort())
+            return false;
+
+        position += numSamples;
+
+        if (! postChunk(chunkUrl, session, sequence++, format, position >= endPosition, shouldAbort, result))
+            return false;
+    }
+
+    return true;
+}
+
+bool ChunkedUploader::postChunk(const juce::String& chunkUrl, const juce::String& session, int sequence, int format, bool isFinal,
+                                const std::function<bool()>& shouldAbort, float& result)
+{
+    const auto url = juce::URL(chunkUrl)
+        .withParameter("session", session)
+        .withParameter("seq", juce::String(sequence))
+        .withParameter("final", isFinal ? "1" : "0");
+
+    //The final answer includes the server's analysis time.
+    client.setTimeoutMs(isFinal ? api::timeoutMs : upload::timeoutMs);
+
+    //Shared with the callback, which may still run after an abort has stopped the wait.
+    struct Reply
+    {
+        juce::WaitableEvent done;
+        AnalysisClient::Result result;
+    };
+
+    auto reply = std::make_shared<Reply>();
+
+    client.postChunk(url, encoder.getBlock(), format, isFinal, [reply](const AnalysisClient::Result& answer)
+        {
+            reply->result = answer;
+            reply->done.signal();
+        });
+
+    while (! reply->done.wait(upload::pollIntervalMs))
+    {
+        if (shouldAbort != nullptr && shouldAbort())
+        {
+            client.cancel(true);
+            return false;
+        }
+    }
+
+    const auto& answer = reply->result;
+
+    if (! answer.succeeded())
+    {
+        lastStatusCode = answer.httpStatusCode;
+        acceptedFormats = answer.acceptedFormats;
+        logger->log(AsyncLogger::Level::warning, "Chunk " + juce::String(sequence) + " failed: " + answer.message);
+        return false;
+    }
+
+    if (isFinal)
+        result = answer.value;
+
+    return true;
+}
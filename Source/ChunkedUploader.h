@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    ChunkedUploader.h
+    Created: 17 Oct 2026 6:15:09pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "CaptureBuffer.h"
+#include "UploadEncoder.h"
+#include "AsyncLogger.h"
+#include "AnalysisClient.h"
+
+//==============================================================================
+/**
+    Streams a capture window to the analysis server while it is being recorded.
+
+    The window is cut into short chunks which are POSTed as soon as the audio
+    thread has written them into the capture ring. Every chunk of one window
+    carries the same session id and a sequence number. The server answers the
+    last chunk (final=1) with the usual {"result": x} JSON, so for a window
+    that ends in the future the result arrives roughly when the capture ends
+    instead of one upload later. The chunks go through the uploader's own
+    AnalysisClient, so each has a deadline and an abort cancels the one in
+    flight.
+*/
+class ChunkedUploader
+{
+public:
+    ChunkedUploader() = default;
+
+    //Allocates the chunk buffer. Call from prepareToPlay.
+    void prepare(int numChannels, double sampleRate);
+
+    //Blocks until the window [startPosition, endPosition) has been sent and the
+    //server has answered. shouldAbort is polled while waiting for audio or an answer.
+    //Every chunk is encoded in format, an UploadFormat.
+    bool run(const juce::String& chunkUrl, const CaptureRingBuffer& ring, juce::int64 startPosition, juce::int64 endPosition,
+             double sampleRate, int format, const std::function<bool()>& shouldAbort, float& result);
+
+    //After a failed run: the HTTP status of the rejected chunk and the formats the server listed, if any.
+    int getLastStatusCode() const { return lastStatusCode; }
+    juce::StringArray getAcceptedFormats() const { return acceptedFormats; }
+
+private:
+    bool postChunk(const juce::String& chunkUrl, const juce::String& session, int sequence, int format, bool isFinal,
+                   const std::function<bool()>& shouldAbort, float& result);
+
+    juce::AudioBuffer<float> bufChunk;
+    UploadEncoder encoder;
+    AnalysisClient client;
+
+    int lastStatusCode = 0;
+    juce::StringArray acceptedFormats;
+    juce::SharedResourcePointer<AsyncLogger> logger;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChunkedUploader)
+};
@@ -32,10 +32,118 @@ namespace parameters
         const int defaultValue;
     };
 
+    struct audioParameterBool
+    {
+        const juce::String id;
+        const juce::String name;
+        const bool defaultValue;
+    };
+
+    struct audioParameterChoice
+    {
+        const juce::String id;
+        const juce::String name;
+        const juce::StringArray choices;
+        const int defaultIndex;
+    };
+
     static const audioParameterFloat volume1{"volume1", "Volume 1", 0, 100, 50};
     static const audioParameterFloat volume2{"volume2", "Volume 2", 0, 100, 50};
     static const audioParameterFloat chorusAmount{"chorusAmount", "Chorus Amount", 0, 100, 50};
     static const audioParameterInt chorusState{"state", "State", 0, 2, 0};
+    static const audioParameterFloat captureSeconds{"captureSeconds", "Capture Length", 0.5f, 10, 2};
+    static const audioParameterChoice backend{"backend", "Backend", {"Native", "HTTP", "Model", "Daemon"}, 0};
+    static const audioParameterChoice mode{"mode", "Mode", {"One-shot", "Continuous", "Timeline"}, 0};
+    static const audioParameterBool streamUpload{"streamUpload", "Stream Upload", false};
+    static const audioParameterBool barAligned{"barAligned", "Bar Aligned", false};
+    static const audioParameterInt windowBars{"windowBars", "Window Bars", 1, 16, 2};
+    //WAV by default, every analysis server decodes it. FLAC is opt-in for servers known to take it.
+    static const audioParameterChoice uploadFormat{"uploadFormat", "Upload Format", {"WAV 24-bit", "WAV 16-bit", "FLAC"}, 0};
+}
+
+//Index order matches parameters::backend.choices
+enum DetectionBackend
+{
+    NATIVE,
+    HTTP,
+    MODEL,
+    DAEMON
+};
+
+//Index order matches parameters::mode.choices
+enum DetectionMode
+{
+    ONE_SHOT,
+    CONTINUOUS,
+    TIMELINE
+};
+
+//Index order matches parameters::uploadFormat.choices and upload::formatNames
+enum UploadFormat
+{
+    WAV_24,
+    WAV_16,
+    FLAC
+};
+
+namespace capture
+{
+    //History kept in the capture ring on top of the longest window, so a snapshot
+    //can still be copied out while the audio thread keeps writing. The ring also
+    //covers poolWaitMs, the longest a finished capture waits before it is copied.
+    static constexpr double headroomSeconds = 1.0;
+
+    //Widest input bus, 7.1.4.
+    static constexpr int maxChannels = 12;
+
+    //How often the message thread launches analysis jobs and applies results.
+    static constexpr int dispatchIntervalMs = 20;
+
+    //Window buffers checked out of CapturePool, across all instances. A window that does not fit
+    //is retried by the message thread for up to poolWaitMs before the evaluation is abandoned, no
+    //worker waits for it. The variable overrides the budget in MB.
+    static constexpr int poolBudgetMB = 64;
+    static constexpr int poolWaitMs = 2000;
+    static const char* const poolBudgetVariable = "CHORUSFIND_CAPTURE_BUDGET_MB";
+
+    //Buffers are rounded up to whole blocks so windows of similar length share them, and a
+    //few returned ones are kept for the next checkout.
+    static constexpr int poolBlockSamples = 16384;
+    static constexpr int poolMaxIdleBuffers = 4;
+}
+
+namespace streaming
+{
+    //How often the continuous mode refreshes chorusAmount.
+    static constexpr int refreshIntervalMs = 200;
+
+    //Span of the running statistics.
+    static constexpr double memorySeconds = 3.0;
+
+    //Largest piece copied out of the capture ring at once.
+    static constexpr double chunkSeconds = 0.1;
+
+    //StereoMeter indicator as a prior: share of the estimate, and hops with signal (10 ms each) before it counts.
+    static constexpr float priorWeight = 0.2f;
+    static constexpr int priorMinHops = 50;
+}
+
+namespace display
+{
+    //Input peak frames per second sent to the editor, and how many can wait for it.
+    static constexpr double peaksPerSecond = 100.0;
+    static constexpr int peakQueueSize = 256;
+
+    //History shown by the waveform, and how often the view looks for new frames.
+    static constexpr double waveformSeconds = 4.0;
+    static constexpr int refreshHz = 30;
+
+    //Meter range and fall-back speed.
+    static constexpr float meterFloorDb = -60.0f;
+    static constexpr float meterDecayDbPerSecond = 24.0f;
+
+    //Telemetry refresh while the diagnostics panel is open.
+    static constexpr int diagnosticsIntervalMs = 250;
 }
 
 namespace text
@@ -44,9 +152,150 @@ namespace text
     static const juce::String textStatus{"Status"};
     static const juce::String textSolo{"Solo"};
     static const juce::String textChorus{"Chorus"};
+    static const juce::String textWindow{"Window"};
+    static const juce::String textBackend{"Backend"};
+    static const juce::String textMode{"Mode"};
+    static const juce::String textStreamUpload{"Stream upload"};
+    static const juce::String textServer{"Server"};
+    static const juce::String textBarAligned{"Align to bars"};
+    static const juce::String textExport{"Export..."};
+    static const juce::String textDiagnostics{"Diagnostics"};
 }
 
 namespace api
 {
+    //Default upload endpoint. The actual one is stored in the plugin state under urlProperty.
     static const juce::String url{"http://127.0.0.1:8000/process-audio/"};
-}
\ No newline at end of file
+    static const juce::Identifier urlProperty{"apiUrl"};
+
+    //Deadline for one complete analysis request.
+    static constexpr int timeoutMs = 10000;
+
+    //Streamed uploads go to the sibling chunk endpoint of the configured URL.
+    inline juce::String chunkUrlFor(const juce::String& uploadUrl)
+    {
+        return uploadUrl.replace("/process-audio/", "/process-audio-chunk/");
+    }
+}
+
+namespace ipc
+{
+    //Shared file of the local analysis daemon (Tools/analysis_daemon.py). The variable overrides the
+    //default path in the user's application data folder, e.g. to put it on a RAM disk.
+    static const char* const fileVariable = "CHORUSFIND_DAEMON_FILE";
+    static const char* const fileName = "ChorusFind/AnalysisDaemon.shm";
+
+    //Deadline for the daemon's answer, and how often the mailboxes are checked while one is due.
+    static constexpr int timeoutMs = 5000;
+    static constexpr int pollIntervalMs = 1;
+}
+
+namespace upload
+{
+    //Length of each piece of a streamed upload.
+    static constexpr double chunkSeconds = 0.25;
+
+    //How often the uploader checks for newly captured audio.
+    static constexpr int pollIntervalMs = 5;
+
+    static constexpr int timeoutMs = 5000;
+
+    //Names of the UploadFormat values on the wire.
+    static const juce::StringArray formatNames{"wav24", "wav16", "flac"};
+
+    //Request header naming the body's format. A server that cannot decode it answers
+    //415 and lists what it can in acceptHeader, the plugin then retries with one of those.
+    static const char* const formatHeader = "X-Audio-Format";
+    static const char* const acceptHeader = "X-Accept-Audio-Format";
+
+    //Lossless on top of 16-bit quantisation, which the decimated analysis signal does not need more than.
+    static constexpr int flacBitsPerSample = 16;
+    static constexpr int flacQuality = 5;
+}
+namespace logging
+{
+    //Records the log queue can hold before messages are dropped.
+    static constexpr int queueSize = 512;
+
+    //Longest message kept by AsyncLogger, longer ones are truncated.
+    static constexpr int maxMessageLength = 160;
+
+    //How often the logger thread formats and flushes queued messages.
+    static constexpr int flushIntervalMs = 50;
+
+    //Environment variables read at startup: level name (debug, info, warning, error, off) and log file path.
+    static const char* const levelVariable = "CHORUSFIND_LOG_LEVEL";
+    static const char* const fileVariable = "CHORUSFIND_LOG_FILE";
+}
+
+namespace cache
+{
+    //Entries kept by ResultCache, the least recently used one is evicted first.
+    static constexpr int maxEntries = 256;
+
+    //Keep results between sessions in the user's application data folder.
+    static constexpr bool persistToDisk = true;
+    static const char* const fileName = "ChorusFind/ResultCache.bin";
+}
+
+namespace scheduler
+{
+    //Worker threads shared by all instances, 0 picks half the CPU cores (at most 4).
+    static constexpr int numThreads = 0;
+    static constexpr int maxThreads = 4;
+
+    //Jobs that can wait for a worker, across all instances.
+    static constexpr int maxQueuedJobs = 64;
+
+    static const char* const threadsVariable = "CHORUSFIND_WORKER_THREADS";
+}
+
+
+namespace offline
+{
+    //Analysis windows of the whole-track timeline built during offline renders.
+    static constexpr double windowSeconds = 2.0;
+    static constexpr double hopSeconds = 0.5;
+
+    //Shortest final window still analysed when a render ends between hops.
+    static constexpr double minTailSeconds = 0.5;
+
+    //Windows copied out and waiting for or under analysis at once.
+    static constexpr int maxWindowsInFlight = 8;
+}
+
+namespace metrics
+{
+    //How often a snapshot of the telemetry is appended to the metrics file.
+    static constexpr int fileIntervalMs = 1000;
+
+    //Environment variable naming the metrics file, JSON lines from every instance. Unset writes nothing.
+    static const char* const fileVariable = "CHORUSFIND_METRICS_FILE";
+}
+
+namespace analysis
+{
+    //Rate of the decimated signal in the capture ring. Detection, uploads and fingerprints all run at it.
+    static constexpr double targetRate = 12000.0;
+
+    //Decimation filter: taps per polyphase branch and -6 dB point as a fraction of the output rate.
+    static constexpr int tapsPerPhase = 48;
+    static constexpr double cutoff = 0.45;
+
+    //Uploads of the decimated window. Mid only halves them again but leaves the server no L/R delay to measure.
+    static constexpr bool uploadMidOnly = false;
+}
+
+namespace model
+{
+    //Weights file of the in-process classifier, written by Tools/chorus_model.py. The variable
+    //overrides the default path in the user's application data folder.
+    static const char* const fileVariable = "CHORUSFIND_MODEL_FILE";
+    static const char* const fileName = "ChorusFind/ChorusModel.cfmodel";
+
+    //Frames whose mel bands are computed with one matrix product.
+    static constexpr int frameBlock = 32;
+
+    //Largest difference from Tools/chorus_model.py on the same samples (float32 here, float64 there).
+    static constexpr float tolerance = 1.0e-4f;
+}
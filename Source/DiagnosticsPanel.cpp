@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    DiagnosticsPanel.cpp
+    Created: 19 Oct 2026 11:05:19am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "DiagnosticsPanel.h"
+
+namespace
+{
+    juce::String formatTiming(const char* name, const Telemetry::Timing& timing)
+    {
+        if (timing.count == 0)
+            return juce::String(name) + "  -";
+
+        return juce::String(name) + "  " + juce::String(timing.lastMs, 1) + " ms  (mean " + juce::String(timing.meanMs, 1)
+             + ", max " + juce::String(timing.maxMs, 1) + ")";
+    }
+
+    juce::String formatPercent(float fraction)
+    {
+        return juce::String(juce::roundToInt(fraction * 100.0f)) + "%";
+    }
+}
+
+DiagnosticsPanel::DiagnosticsPanel()
+    : btnReset("Reset")
+{
+    btnReset.onClick = [this]
+    {
+        if (onReset)
+            onReset();
+    };
+
+    addAndMakeVisible(btnReset);
+}
+
+void DiagnosticsPanel::setSnapshot(const Telemetry::Snapshot& newSnapshot)
+{
+    snapshot = newSnapshot;
+    repaint();
+}
+
+void DiagnosticsPanel::resized()
+{
+    btnReset.setBounds(getWidth() - 50, getHeight() - 20, 50, 20);
+}
+
+void DiagnosticsPanel::paint(juce::Graphics& g)
+{
+    g.setColour(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId).darker(0.3f));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 4.0f);
+
+    auto area = getLocalBounds().reduced(6);
+    auto histogramArea = area.removeFromRight(150).withTrimmedBottom(22);
+
+    //Text column.
+    const juce::StringArray lines{
+        "Load  " + juce::String(snapshot.lastLoad, 1) + "%  (max " + juce::String(snapshot.maxLoad, 1) + "%, "
+            + juce::String((juce::int64)snapshot.numBlocks) + " blocks)",
+        "Capture ring " + formatPercent(snapshot.ringFill) + ",  window " + formatPercent(snapshot.windowFill),
+        "Queues  cmd " + juce::String(snapshot.commandQueueDepth) + ",  res " + juce::String(snapshot.resultQueueDepth)
+            + ",  jobs " + juce::String(snapshot.jobQueueDepth) + ",  offline " + juce::String(snapshot.offlinePending),
+        formatTiming("Analysis", snapshot.analysis),
+        formatTiming("Round trip", snapshot.roundTrip)
+    };
+
+    g.setColour(juce::Colours::white);
+    g.setFont(juce::Font(11.0f));
+
+    for (const auto& line : lines)
+        g.drawText(line, area.removeFromTop(16), juce::Justification::centredLeft, true);
+
+    //Load histogram, bar heights relative to the fullest bucket.
+    juce::uint32 largest = 1;
+
+    for (const auto count : snapshot.loadHistogram)
+        largest = juce::jmax(largest, count);
+
+    auto labelArea = histogramArea.removeFromBottom(12);
+    const float barWidth = (float)histogramArea.getWidth() / Telemetry::numLoadBuckets;
+
+    for (int i = 0; i < Telemetry::numLoadBuckets; ++i)
+    {
+        const float height = histogramArea.getHeight() * (float)snapshot.loadHistogram[i] / (float)largest;
+        const auto bar = juce::Rectangle<float>((float)histogramArea.getX() + i * barWidth + 1.0f, (float)histogramArea.getBottom() - height,
+                                                barWidth - 2.0f, height);
+
+        //Blocks over the budget are the ones that cause dropouts.
+        g.setColour(i == Telemetry::numLoadBuckets - 1 ? juce::Colours::red : i >= Telemetry::numLoadBuckets - 3 ? juce::Colours::orange : juce::Colours::lightgreen);
+        g.fillRect(bar);
+
+        const auto label = i < Telemetry::numLoadBuckets - 1 ? juce::String(juce::roundToInt(Telemetry::loadBucketEdges[i])) : juce::String(">");
+        g.setColour(juce::Colours::lightgrey);
+        g.setFont(juce::Font(9.0f));
+        g.drawText(label, juce::Rectangle<float>((float)labelArea.getX() + i * barWidth, (float)labelArea.getY(), barWidth, (float)labelArea.getHeight()),
+                   juce::Justification::centred, false);
+    }
+}
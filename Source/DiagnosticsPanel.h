@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    DiagnosticsPanel.h
+    Created: 19 Oct 2026 11:05:19am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Telemetry.h"
+
+//==============================================================================
+/**
+    Compact view of a Telemetry::Snapshot: the processBlock load histogram on
+    the right, the latest levels and timings as text on the left.
+*/
+class DiagnosticsPanel : public juce::Component
+{
+public:
+    DiagnosticsPanel();
+
+    void setSnapshot(const Telemetry::Snapshot& newSnapshot);
+
+    //Called when the user resets the counters.
+    std::function<void()> onReset;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    Telemetry::Snapshot snapshot;
+
+    juce::TextButton btnReset;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DiagnosticsPanel)
+};
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    JobScheduler.cpp
+    Created: 18 Oct 2026 4:40:15pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "JobScheduler.h"
+#include "Config.h"
+
+JobScheduler::JobScheduler()
+{
+    const int numThreads = chooseNumThreads();
+
+    for (int i = 0; i < numThreads; ++i)
+        workers.add(new Worker(*this, i))->startThread(juce::Thread::Priority::low);
+}
+
+JobScheduler::~JobScheduler()
+{
+    //Clients hold the scheduler, so every client is gone and the queue is empty here.
+    for (auto* worker : workers)
+        worker->signalThreadShouldExit();
+
+    for (auto* worker : workers)
+    {
+        jobAdded.signal();
+        worker->stopThread(2000);
+    }
+}
+
+int JobScheduler::chooseNumThreads()
+{
+    const int fromEnvironment = juce::SystemStats::getEnvironmentVariable(scheduler::threadsVariable, {}).getIntValue();
+
+    if (fromEnvironment > 0)
+        return fromEnvironment;
+
+    if (scheduler::numThreads > 0)
+        return scheduler::numThreads;
+
+    return juce::jlimit(1, scheduler::maxThreads, juce::SystemStats::getNumCpus() / 2);
+}
+
+int JobScheduler::getNumQueuedJobs() const
+{
+    const juce::ScopedLock sl(lock);
+    return queue.size();
+}
+
+bool JobScheduler::add(Client* owner, int key, Priority priority, std::function<void()> function)
+{
+    //The job a newer one replaces is destroyed after the lock is released, with whatever it captured.
+    std::function<void()> replaced;
+
+    {
+        const juce::ScopedLock sl(lock);
+
+        //A job from the same client with the same key is still waiting, the newer request replaces it.
+        for (auto& job : queue)
+        {
+            if (job.owner == owner && job.key == key)
+            {
+                replaced = std::move(job.function);
+                job.function = std::move(function);
+                job.priority = juce::jmax(job.priority, priority);
+                return true;
+            }
+        }
+
+        if (queue.size() >= scheduler::maxQueuedJobs)
+            return false;
+
+        queue.add({ owner, key, priority, nextSequence++, std::move(function) });
+    }
+
+    jobAdded.signal();
+    return true;
+}
+
+void JobScheduler::cancel(Client* owner)
+{
+    for (;;)
+    {
+        {
+            const juce::ScopedLock sl(lock);
+            queue.removeIf([owner](const Job& job) { return job.owner == owner; });
+
+            if (! running.contains(owner))
+                return;
+
+            //Reset under the lock, so a job that finishes after the check signals after the reset.
+            jobFinished.reset();
+        }
+
+        jobFinished.wait();
+    }
+}
+
+bool JobScheduler::takeNext(Job& job)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (queue.isEmpty())
+        return false;
+
+    int best = 0;
+
+    for (int i = 1; i < queue.size(); ++i)
+    {
+        const auto& candidate = queue.getReference(i);
+        const auto& current = queue.getReference(best);
+
+        if (candidate.priority > current.priority
+            || (candidate.priority == current.priority && candidate.sequence < current.sequence))
+            best = i;
+    }
+
+    job = std::move(queue.getReference(best));
+    queue.remove(best);
+    running.add(job.owner);
+
+    //More work is waiting, wake another worker.
+    if (! queue.isEmpty())
+        jobAdded.signal();
+
+    return true;
+}
+
+void JobScheduler::finished(Client* owner)
+{
+    {
+        const juce::ScopedLock sl(lock);
+        running.removeFirstMatchingValue(owner);
+    }
+
+    jobFinished.signal();
+}
+
+//==============================================================================
+JobScheduler::Worker::Worker(JobScheduler& owner, int index)
+    : juce::Thread("ChorusFind worker " + juce::String(index + 1))
+    , scheduler(owner)
+{
+}
+
+void JobScheduler::Worker::run()
+{
+    while (! threadShouldExit())
+    {
+        Job job;
+
+        if (! scheduler.takeNext(job))
+        {
+            scheduler.jobAdded.wait(100);
+            continue;
+        }
+
+        job.function();
+        scheduler.finished(job.owner);
+    }
+}
+
+//==============================================================================
+JobScheduler::Client::Client()
+{
+}
+
+JobScheduler::Client::~Client()
+{
+    cancelAll();
+}
+
+bool JobScheduler::Client::schedule(int key, Priority priority, std::function<void()> job)
+{
+    if (cancelled)
+        return false;
+
+    return scheduler->add(this, key, priority, std::move(job));
+}
+
+void JobScheduler::Client::cancelAll()
+{
+    cancelled = true;
+    scheduler->cancel(this);
+}
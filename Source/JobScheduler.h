@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    JobScheduler.h
+    Created: 18 Oct 2026 4:40:15pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Worker threads shared by every plugin instance in the process.
+
+    The queue is bounded (scheduler::maxQueuedJobs) and ordered by priority,
+    first in first out within a priority. Instances do not use the scheduler
+    directly but through a JobScheduler::Client, which tags its jobs so that:
+     - scheduling a job with the same key as one still waiting replaces the
+       waiting one instead of queueing a second. The replaced job is dropped
+       without being run, so a key must only be shared by jobs where the
+       newest one does all the work, never by jobs that each clean up or
+       complete something,
+     - destroying the client removes its waiting jobs and blocks until its
+       running jobs have returned, so no job outlives the instance.
+
+    The number of threads is scheduler::numThreads, or the
+    CHORUSFIND_WORKER_THREADS environment variable when set.
+*/
+class JobScheduler
+{
+public:
+    enum class Priority
+    {
+        background,
+        normal,
+        high
+    };
+
+    JobScheduler();
+    ~JobScheduler();
+
+    int getNumThreads() const noexcept { return workers.size(); }
+    int getNumQueuedJobs() const;
+
+    //==============================================================================
+    class Client
+    {
+    public:
+        Client();
+        ~Client();
+
+        //Returns false if the queue is full or the client was cancelled. Any thread except the audio thread.
+        //A job of this client with the same key that is still waiting is dropped, never run.
+        bool schedule(int key, Priority priority, std::function<void()> job);
+
+        //Removes waiting jobs and waits for running ones. Jobs can poll isCancelled() to return early.
+        void cancelAll();
+        bool isCancelled() const noexcept { return cancelled.load(); }
+
+        //Accepts jobs again after cancelAll().
+        void resume() noexcept { cancelled = false; }
+
+        //Jobs of all clients waiting for a worker.
+        int getNumQueuedJobs() const { return scheduler->getNumQueuedJobs(); }
+
+    private:
+        juce::SharedResourcePointer<JobScheduler> scheduler;
+        std::atomic<bool> cancelled{ false };
+
+        JUCE_DECLARE_NON_COPYABLE(Client)
+    };
+
+private:
+    struct Job
+    {
+        Client* owner;
+        int key;
+        Priority priority;
+        juce::uint64 sequence;
+        std::function<void()> function;
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(JobScheduler& owner, int index);
+        void run() override;
+
+    private:
+        JobScheduler& scheduler;
+    };
+
+    bool add(Client* owner, int key, Priority priority, std::function<void()> function);
+    void cancel(Client* owner);
+    bool takeNext(Job& job);
+    void finished(Client* owner);
+
+    static int chooseNumThreads();
+
+    juce::CriticalSection lock;
+    juce::Array<Job> queue;
+    juce::Array<Client*> running;
+    juce::uint64 nextSequence = 0;
+
+    juce::WaitableEvent jobAdded;
+
+    //Manual reset, so every client waiting in cancel() wakes up and checks its own jobs.
+    juce::WaitableEvent jobFinished{ true };
+
+    juce::OwnedArray<Worker> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(JobScheduler)
+};
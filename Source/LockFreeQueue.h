@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    LockFreeQueue.h
+    Created: 18 Oct 2026 9:12:40am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+/**
+    Fixed-capacity single-producer / single-consumer queue.
+
+    Storage is part of the object, push() and pop() never allocate or lock and
+    are safe to call from the audio thread. Built on juce::AbstractFifo.
+*/
+template <typename ItemType, int Capacity>
+class SpscQueue
+{
+public:
+    SpscQueue() = default;
+
+    //Producer thread only. Returns false if the queue is full.
+    bool push(const ItemType& item) noexcept
+    {
+        const auto scope = fifo.write(1);
+
+        if (scope.blockSize1 == 0)
+            return false;
+
+        items[(size_t)scope.startIndex1] = item;
+        return true;
+    }
+
+    //Consumer thread only. Returns false if the queue is empty.
+    bool pop(ItemType& item) noexcept
+    {
+        const auto scope = fifo.read(1);
+
+        if (scope.blockSize1 == 0)
+            return false;
+
+        item = items[(size_t)scope.startIndex1];
+        return true;
+    }
+
+    int getNumReady() const noexcept
+    {
+        return fifo.getNumReady();
+    }
+
+private:
+    //AbstractFifo keeps one slot free to tell full from empty.
+    juce::AbstractFifo fifo{ Capacity + 1 };
+    std::array<ItemType, Capacity + 1> items{};
+
+    JUCE_DECLARE_NON_COPYABLE(SpscQueue)
+};
+
+//==============================================================================
+/**
+    Fixed-capacity multi-producer / single-consumer queue.
+
+    Bounded queue with a sequence number per cell (Vyukov): producers claim a
+    cell with one compare-and-swap, so any number of threads can push without
+    locks while a single consumer pops. Capacity must be a power of two.
+*/
+template <typename ItemType, int Capacity>
+class MpscQueue
+{
+public:
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    MpscQueue()
+    {
+        for (size_t i = 0; i < (size_t)Capacity; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    //Any thread. Returns false if the queue is full.
+    bool push(const ItemType& item) noexcept
+    {
+        auto position = enqueuePosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& cell = cells[position & mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+
+            if (difference == 0)
+            {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.item = item;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //Consumer thread only. Returns false if the queue is empty.
+    bool pop(ItemType& item) noexcept
+    {
+        const auto position = dequeuePosition.load(std::memory_order_relaxed);
+        auto& cell = cells[position & mask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+
+        if ((std::ptrdiff_t)sequence - (std::ptrdiff_t)(position + 1) < 0)
+            return false;
+
+        item = cell.item;
+        cell.sequence.store(position + Capacity, std::memory_order_release);
+        dequeuePosition.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //Approximate, for diagnostics.
+    int getNumReady() const noexcept
+    {
+        return (int)(enqueuePosition.load(std::memory_order_relaxed) - dequeuePosition.load(std::memory_order_relaxed));
+    }
+
+private:
+    static constexpr size_t mask = (size_t)Capacity - 1;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence{ 0 };
+        ItemType item{};
+    };
+
+    std::array<Cell, (size_t)Capacity> cells;
+    std::atomic<size_t> enqueuePosition{ 0 };
+    std::atomic<size_t> dequeuePosition{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(MpscQueue)
+};
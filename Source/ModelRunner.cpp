@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+    ModelRunner.cpp
+    Created: 22 Oct 2026 11:02:14am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ModelRunner.h"
+#include "AnalysisKernels.h"
+#include "Config.h"
+
+namespace
+{
+    //Added to every mel band before the log, the same as the reference.
+    constexpr float logFloor = 1.0e-6f;
+
+    double hzToMel(double hz)
+    {
+        return 2595.0 * std::log10(1.0 + hz / 700.0);
+    }
+
+    double melToHz(double mel)
+    {
+        return 700.0 * (std::pow(10.0, mel / 2595.0) - 1.0);
+    }
+}
+
+void ModelRunner::prepare(const ChorusModel& modelToRun, double sampleRate, int maxSamples)
+{
+    model = &modelToRun;
+    prepareFrontEnd(sampleRate);
+
+    const int numFeatures = model->getNumFeatures();
+    maxFrames = maxSamples >= fftSize ? 1 + (maxSamples - fftSize) / hopSize : 0;
+
+    //Largest activation any layer produces for the longest window.
+    int frames = maxFrames;
+    int width = numFeatures;
+    size_t largestTensor = 1;
+
+    for (auto* layer : model->getLayers())
+    {
+        if (layer->type == ChorusModel::LayerType::conv1d)
+            frames = juce::jmax(1, frames - layer->kernelSize + 1);
+        else if (layer->type == ChorusModel::LayerType::meanPool)
+            frames = 1;
+
+        width = layer->numOutputs;
+        largestTensor = juce::jmax(largestTensor, (size_t)frames * (size_t)width);
+    }
+
+    const size_t powerSize = (size_t)model::frameBlock * (size_t)numBins;
+    const size_t featureSize = (size_t)juce::jmax(1, maxFrames) * (size_t)numFeatures;
+
+    arena.allocate(2 * (size_t)fftSize + 2 * powerSize + featureSize + 2 * largestTensor, true);
+
+    fftBuffer = arena.get();
+    midPower = fftBuffer + 2 * fftSize;
+    sidePower = midPower + powerSize;
+    features = sidePower + powerSize;
+    tensors[0] = features + featureSize;
+    tensors[1] = tensors[0] + largestTensor;
+
+    //Resolves the kernel set here rather than on the first window.
+    kernels::get();
+}
+
+void ModelRunner::prepareFrontEnd(double sampleRate)
+{
+    const auto& settings = model->getFrontEnd();
+
+    fftSize = settings.fftSize;
+    numBins = fftSize / 2 + 1;
+    hopSize = juce::jmax(1, juce::roundToInt(settings.hopSeconds * sampleRate));
+    numMels = settings.numMels;
+
+    //Periodic Hann.
+    window.allocate((size_t)fftSize, false);
+
+    for (int i = 0; i < fftSize; ++i)
+        window[i] = (float)(0.5 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * i / fftSize));
+
+    //e^(-2 pi i k / N) for the forward transform.
+    twiddles.allocate((size_t)fftSize, false);
+
+    for (int k = 0; k < fftSize / 2; ++k)
+    {
+        twiddles[2 * k] = (float)std::cos(juce::MathConstants<double>::twoPi * k / fftSize);
+        twiddles[2 * k + 1] = (float)-std::sin(juce::MathConstants<double>::twoPi * k / fftSize);
+    }
+
+    bitReversed.allocate((size_t)fftSize, false);
+    int numBits = 0;
+
+    while ((1 << numBits) < fftSize)
+        ++numBits;
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        int reversed = 0;
+
+        for (int bit = 0; bit < numBits; ++bit)
+            reversed |= ((i >> bit) & 1) << (numBits - 1 - bit);
+
+        bitReversed[i] = reversed;
+    }
+
+    //Triangular filters, numMels + 2 edges evenly spaced in mel. Rows are bands, as matrixMultiply wants them.
+    melFilters.allocate((size_t)(numMels * numBins), true);
+
+    const double maxHz = juce::jmin((double)settings.maxHz, sampleRate * 0.5);
+    const double minMel = hzToMel(settings.minHz);
+    const double maxMel = hzToMel(maxHz);
+
+    for (int band = 0; band < numMels; ++band)
+    {
+        const double lower = melToHz(minMel + (maxMel - minMel) * band / (numMels + 1));
+        const double centre = melToHz(minMel + (maxMel - minMel) * (band + 1) / (numMels + 1));
+        const double upper = melToHz(minMel + (maxMel - minMel) * (band + 2) / (numMels + 1));
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const double hz = bin * sampleRate / fftSize;
+            const double weight = juce::jmin((hz - lower) / (centre - lower), (upper - hz) / (upper - centre));
+            melFilters[band * numBins + bin] = (float)juce::jmax(0.0, weight);
+        }
+    }
+}
+
+void ModelRunner::transform() noexcept
+{
+    //Iterative radix-2, interleaved re/im in fftBuffer.
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const int j = bitReversed[i];
+
+        if (j > i)
+        {
+            std::swap(fftBuffer[2 * i], fftBuffer[2 * j]);
+            std::swap(fftBuffer[2 * i + 1], fftBuffer[2 * j + 1]);
+        }
+    }
+
+    for (int size = 2; size <= fftSize; size <<= 1)
+    {
+        const int half = size / 2;
+        const int step = fftSize / size;
+
+        for (int start = 0; start < fftSize; start += size)
+        {
+            for (int k = 0; k < half; ++k)
+            {
+                const float wr = twiddles[2 * k * step];
+                const float wi = twiddles[2 * k * step + 1];
+
+                auto* even = fftBuffer + 2 * (start + k);
+                auto* odd = fftBuffer + 2 * (start + k + half);
+
+                const float tr = odd[0] * wr - odd[1] * wi;
+                const float ti = odd[0] * wi + odd[1] * wr;
+
+                odd[0] = even[0] - tr;
+                odd[1] = even[1] - ti;
+                even[0] += tr;
+                even[1] += ti;
+            }
+        }
+    }
+}
+
+void ModelRunner::computeFeatures(const float* left, const float* right, int numFrames) noexcept
+{
+    const int numFeatures = model->getNumFeatures();
+    const float* mean = model->getFeatureMean();
+    const float* scale = model->getFeatureScale();
+    const float powerScale = 1.0f / fftSize;
+
+    for (int blockStart = 0; blockStart < numFrames; blockStart += model::frameBlock)
+    {
+        const int blockFrames = juce::jmin(model::frameBlock, numFrames - blockStart);
+
+        for (int f = 0; f < blockFrames; ++f)
+        {
+            const int offset = (blockStart + f) * hopSize;
+
+            //Mid in the real part, side in the imaginary part: one transform for both.
+            for (int i = 0; i < fftSize; ++i)
+            {
+                const float l = left[offset + i];
+                const float r = right[offset + i];
+                fftBuffer[2 * i] = 0.5f * (l + r) * window[i];
+                fftBuffer[2 * i + 1] = 0.5f * (l - r) * window[i];
+            }
+
+            transform();
+
+            //Split Z = M + iS using the conjugate symmetry of real signals' spectra.
+            auto* mid = midPower + f * numBins;
+            auto* side = sidePower + f * numBins;
+
+            for (int k = 0; k < numBins; ++k)
+            {
+                const int mirrored = (fftSize - k) & (fftSize - 1);
+                const float a = fftBuffer[2 * k];
+                const float b = fftBuffer[2 * k + 1];
+                const float c = fftBuffer[2 * mirrored];
+                const float d = fftBuffer[2 * mirrored + 1];
+
+                mid[k] = 0.25f * ((a + c) * (a + c) + (b - d) * (b - d)) * powerScale;
+                side[k] = 0.25f * ((b + d) * (b + d) + (a - c) * (a - c)) * powerScale;
+            }
+        }
+
+        //Mel bands of the whole block: mid into the first half of each feature row, side into the second.
+        auto* rows = features + blockStart * numFeatures;
+        kernels::matrixMultiply(midPower, numBins, melFilters, numBins, rows, numFeatures, blockFrames, numMels);
+        kernels::matrixMultiply(sidePower, numBins, melFilters, numBins, rows + numMels, numFeatures, blockFrames, numMels);
+
+        for (int f = 0; f < blockFrames; ++f)
+        {
+            auto* row = rows + f * numFeatures;
+
+            for (int j = 0; j < numFeatures; ++j)
+                row[j] = (std::log(row[j] + logFloor) - mean[j]) * scale[j];
+        }
+    }
+}
+
+bool ModelRunner::run(const juce::AudioBuffer<float>& pair, float& result) noexcept
+{
+    if (model == nullptr)
+        return false;
+
+    const int numSamples = pair.getNumSamples();
+    const int numFrames = numSamples >= fftSize ? juce::jmin(maxFrames, 1 + (numSamples - fftSize) / hopSize) : 0;
+
+    if (numFrames < model->getMinFrames())
+        return false;
+
+    computeFeatures(pair.getReadPointer(0), pair.getReadPointer(juce::jmin(1, pair.getNumChannels() - 1)), numFrames);
+
+    //Activations go back and forth between the two tensors, element-wise layers work in place.
+    float* input = features;
+    int frames = numFrames;
+    int width = model->getNumFeatures();
+    int next = 0;
+
+    for (auto* layer : model->getLayers())
+    {
+        switch (layer->type)
+        {
+        case ChorusModel::LayerType::conv1d:
+        case ChorusModel::LayerType::dense:
+        {
+            //A dense layer is a convolution with a kernel of one frame.
+            const int outFrames = frames - layer->kernelSize + 1;
+            auto* output = tensors[next];
+
+            kernels::matrixMultiply(input, width, layer->weights, layer->kernelSize * width, output, layer->numOutputs, outFrames, layer->numOutputs);
+
+            for (int t = 0; t < outFrames; ++t)
+                juce::FloatVectorOperations::add(output + t * layer->numOutputs, layer->bias, layer->numOutputs);
+
+            input = output;
+            next = 1 - next;
+            frames = outFrames;
+            width = layer->numOutputs;
+            break;
+        }
+
+        case ChorusModel::LayerType::relu:
+            juce::FloatVectorOperations::max(input, input, 0.0f, frames * width);
+            break;
+
+        case ChorusModel::LayerType::meanPool:
+        {
+            auto* output = tensors[next];
+            juce::FloatVectorOperations::copy(output, input, width);
+
+            for (int t = 1; t < frames; ++t)
+                juce::FloatVectorOperations::add(output, input + t * width, width);
+
+            juce::FloatVectorOperations::multiply(output, 1.0f / frames, width);
+
+            input = output;
+            next = 1 - next;
+            frames = 1;
+            break;
+        }
+
+        case ChorusModel::LayerType::sigmoid:
+            for (int i = 0; i < frames * width; ++i)
+                input[i] = 1.0f / (1.0f + std::exp(-input[i]));
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    result = juce::jlimit(0.0f, 1.0f, input[0]);
+    return true;
+}
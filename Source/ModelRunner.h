@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ModelRunner.h
+    Created: 22 Oct 2026 11:02:14am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ChorusModel.h"
+
+//==============================================================================
+/**
+    Runs a ChorusModel on one channel pair of a capture window.
+
+    Front end: mid and side are framed (fftSize, hopSeconds), Hann windowed
+    and transformed together as one complex FFT, their power spectra go
+    through a triangular mel filterbank (HTK mel scale), and the log of each
+    band is normalised with the model's mean and scale. Frames are handled in
+    blocks so the filterbank is one matrix product per block.
+
+    Network: every convolution and dense layer is a single
+    kernels::matrixMultiply over all frames, the convolutions without any
+    im2col copy because consecutive frames are already contiguous.
+
+    Everything lives in one arena allocated by prepare() for the longest
+    window, run() never allocates. Results match Tools/chorus_model.py on the
+    same samples within model::tolerance. One runner per thread.
+*/
+class ModelRunner
+{
+public:
+    ModelRunner() = default;
+
+    //Sizes the arena for windows of up to maxSamples at sampleRate.
+    void prepare(const ChorusModel& modelToRun, double sampleRate, int maxSamples);
+    bool isPrepared() const noexcept { return model != nullptr; }
+
+    //0-1 chorus amount of the first two channels of pair. False if the window is too short for the model.
+    bool run(const juce::AudioBuffer<float>& pair, float& result) noexcept;
+
+private:
+    void prepareFrontEnd(double sampleRate);
+    void computeFeatures(const float* left, const float* right, int numFrames) noexcept;
+    void transform() noexcept;
+
+    const ChorusModel* model = nullptr;
+
+    //Front end
+    int fftSize = 0;
+    int numBins = 0;
+    int hopSize = 0;
+    int numMels = 0;
+    juce::HeapBlock<float> window;
+    juce::HeapBlock<float> twiddles;
+    juce::HeapBlock<int> bitReversed;
+    juce::HeapBlock<float> melFilters;
+
+    //Arena and the regions in it
+    juce::HeapBlock<float> arena;
+    float* fftBuffer = nullptr;
+    float* midPower = nullptr;
+    float* sidePower = nullptr;
+    float* features = nullptr;
+    float* tensors[2] = { nullptr, nullptr };
+    int maxFrames = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModelRunner)
+};
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    OfflineAnalyser.cpp
+    Created: 18 Oct 2026 8:03:21pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "OfflineAnalyser.h"
+#include "Config.h"
+
+OfflineAnalyser::OfflineAnalyser(const CaptureRingBuffer& ringToRead, ChorusTimeline& timelineToFill)
+    : ring(ringToRead)
+    , timeline(timelineToFill)
+{
+    for (int i = 0; i < offline::maxWindowsInFlight; ++i)
+        slots.add(new Slot());
+}
+
+OfflineAnalyser::~OfflineAnalyser()
+{
+    jobs.cancelAll();
+}
+
+void OfflineAnalyser::begin(double newSampleRate, double startSeconds, juce::int64 ringStart)
+{
+    //Results of an earlier render must not land in the new timeline.
+    jobs.cancelAll();
+    jobs.resume();
+
+    sampleRate = newSampleRate;
+    firstPosition = ringStart;
+    windowSamples = (int)std::llround(offline::windowSeconds * sampleRate);
+    hopSamples = offline::hopSeconds * sampleRate;
+    nextHop = 0;
+
+    //Cancelled jobs never released their slots.
+    for (auto* slot : slots)
+    {
+        slot->buffer.setSize(2, windowSamples);
+        slot->detector.prepare(sampleRate);
+        slot->busy = false;
+    }
+
+    numPending = 0;
+
+    timeline.clear(startSeconds, offline::hopSeconds, offline::windowSeconds);
+    active = true;
+}
+
+void OfflineAnalyser::advance(juce::int64 written)
+{
+    if (! active)
+        return;
+
+    for (;;)
+    {
+        const auto start = firstPosition + (juce::int64)std::llround(nextHop * hopSamples);
+
+        if (start + windowSamples > written)
+            break;
+
+        schedule(nextHop++, start, windowSamples);
+    }
+}
+
+void OfflineAnalyser::end(juce::int64 written)
+{
+    if (! active)
+        return;
+
+    advance(written);
+
+    //A tail shorter than a window is still worth a value if it holds a few frames.
+    const auto start = firstPosition + (juce::int64)std::llround(nextHop * hopSamples);
+    const int tail = (int)juce::jmin((juce::int64)windowSamples, written - start);
+
+    if (tail >= (int)(offline::minTailSeconds * sampleRate))
+        schedule(nextHop++, start, tail);
+
+    active = false;
+}
+
+OfflineAnalyser::Slot* OfflineAnalyser::waitForFreeSlot()
+{
+    for (;;)
+    {
+        for (auto* slot : slots)
+            if (! slot->busy.load())
+                return slot;
+
+        slotFreed.wait(10);
+    }
+}
+
+void OfflineAnalyser::schedule(int hop, juce::int64 start, int numSamples)
+{
+    auto* slot = waitForFreeSlot();
+
+    //The timeline grows here on the render thread, so the worker's set() only writes the value.
+    timeline.reserve(hop + 1);
+
+    //Shrinking keeps the allocation made in begin().
+    slot->buffer.setSize(2, numSamples, false, false, true);
+
+    //The ring moved past the window before it could be copied. The hop stays unanalysed, a gap in the
+    //timeline rather than a value from the wrong audio.
+    if (! ring.copyRange(slot->buffer, start, numSamples))
+    {
+        logger->log(AsyncLogger::Level::warning, "Offline window for hop %g was overwritten before it could be read, left empty.", (double)hop);
+        return;
+    }
+
+    slot->busy = true;
+    ++numPending;
+
+    const auto job = [this, slot, hop]()
+    {
+        timeline.set(hop, slot->detector.analyse(slot->buffer, sampleRate));
+
+        --numPending;
+        slot->busy = false;
+        slotFreed.signal();
+    };
+
+    //Every window has its own key, nothing is coalesced. If the queue is full, wait and retry.
+    while (! jobs.schedule(hop, JobScheduler::Priority::background, job))
+    {
+        if (jobs.isCancelled())
+        {
+            --numPending;
+            slot->busy = false;
+            return;
+        }
+
+        juce::Thread::sleep(5);
+    }
+}
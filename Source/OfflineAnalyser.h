@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    OfflineAnalyser.h
+    Created: 18 Oct 2026 8:03:21pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "CaptureBuffer.h"
+#include "ChorusDetector.h"
+#include "ChorusTimeline.h"
+#include "JobScheduler.h"
+#include "AsyncLogger.h"
+
+//==============================================================================
+/**
+    Builds a ChorusTimeline while the host renders offline.
+
+    The render thread calls advance() after every block. Each window of
+    offline::windowSeconds that has been completely captured (one every
+    offline::hopSeconds) is copied out of the capture ring into a free slot
+    and analysed on the shared worker threads, so windows are processed in
+    parallel and the render runs as fast as the CPU allows. When every slot is
+    busy, advance() waits for one: the render thread is not real-time, and the
+    wait keeps memory bounded. A window the ring no longer holds is logged
+    and its hop left unanalysed (NaN).
+
+    begin() / advance() / end() are for the render thread only.
+*/
+class OfflineAnalyser
+{
+public:
+    OfflineAnalyser(const CaptureRingBuffer& ringToRead, ChorusTimeline& timelineToFill);
+    ~OfflineAnalyser();
+
+    //Starts a new timeline. ringStart is the ring position of host time startSeconds.
+    void begin(double sampleRate, double startSeconds, juce::int64 ringStart);
+
+    //Schedules every window that ends at or before written.
+    void advance(juce::int64 written);
+
+    //Analyses a final partial window if the render stopped between hops.
+    void end(juce::int64 written);
+
+    bool isActive() const noexcept { return active; }
+
+    //Windows scheduled but not analysed yet.
+    int getNumPending() const noexcept { return numPending.load(); }
+
+private:
+    struct Slot
+    {
+        juce::AudioBuffer<float> buffer;
+        ChorusDetector detector;
+        std::atomic<bool> busy{ false };
+    };
+
+    Slot* waitForFreeSlot();
+    void schedule(int hop, juce::int64 start, int numSamples);
+
+    const CaptureRingBuffer& ring;
+    ChorusTimeline& timeline;
+    juce::SharedResourcePointer<AsyncLogger> logger;
+
+    JobScheduler::Client jobs;
+    juce::OwnedArray<Slot> slots;
+    juce::WaitableEvent slotFreed;
+    std::atomic<int> numPending{ 0 };
+
+    bool active = false;
+    double sampleRate = 44100.0;
+    juce::int64 firstPosition = 0;
+    int windowSamples = 0;
+    double hopSamples = 0.0;
+    int nextHop = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineAnalyser)
+};
@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    PeakFifo.h
+    Created: 20 Oct 2026 2:27:44pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+#include "LockFreeQueue.h"
+
+//==============================================================================
+/**
+    Min/max peaks of the input for the editor's waveform and meter.
+
+    The audio thread folds every display::peaksPerSecond-th of a second of
+    input into one frame and pushes it into a lock-free queue, the editor pops
+    the frames on the message thread. That is a few dozen frames per second
+    instead of the audio itself. While no editor drains the queue it fills up
+    and new frames are dropped.
+
+    All memory is part of the object; push() never allocates or locks.
+*/
+class PeakFifo
+{
+public:
+    struct Frame
+    {
+        float min[2];
+        float max[2];
+    };
+
+    PeakFifo() = default;
+
+    //Call from prepareToPlay only.
+    void prepare(double sampleRate)
+    {
+        samplesPerFrame = juce::jmax(1, juce::roundToInt(sampleRate / display::peaksPerSecond));
+        resetFrame();
+    }
+
+    //Audio thread only. Channels beyond the second are not shown, a mono input fills both.
+    void push(const juce::AudioBuffer<float>& source, int numInputChannels) noexcept
+    {
+        const int numChannels = juce::jmin(2, numInputChannels);
+
+        for (int start = 0; start < source.getNumSamples();)
+        {
+            const int numSamples = juce::jmin(samplesPerFrame - frameSamples, source.getNumSamples() - start);
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                if (numChannels == 0)
+                    continue;
+
+                const auto range = juce::FloatVectorOperations::findMinAndMax(source.getReadPointer(juce::jmin(channel, numChannels - 1), start), numSamples);
+                frame.min[channel] = juce::jmin(frame.min[channel], range.getStart());
+                frame.max[channel] = juce::jmax(frame.max[channel], range.getEnd());
+            }
+
+            start += numSamples;
+            frameSamples += numSamples;
+
+            if (frameSamples == samplesPerFrame)
+            {
+                //Silence if there was no input to look at.
+                if (numChannels == 0)
+                    frame = {};
+
+                frames.push(frame);
+                resetFrame();
+            }
+        }
+    }
+
+    //Consumer (message) thread only.
+    bool pop(Frame& result) noexcept
+    {
+        return frames.pop(result);
+    }
+
+private:
+    void resetFrame() noexcept
+    {
+        frame = { { 1.0e9f, 1.0e9f }, { -1.0e9f, -1.0e9f } };
+        frameSamples = 0;
+    }
+
+    SpscQueue<Frame, display::peakQueueSize> frames;
+
+    //Audio thread only.
+    Frame frame{};
+    int frameSamples = 0;
+    int samplesPerFrame = 1;
+
+    JUCE_DECLARE_NON_COPYABLE(PeakFifo)
+};
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    PlanarBuffer.h
+    Created: 21 Oct 2026 10:12:06am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Planar multichannel buffer with every channel on its own cache line.
+
+    One block is allocated in allocate(), each channel starts on a
+    planarAlignment boundary so the SIMD kernels get aligned rows no matter
+    how many channels there are. The AudioBuffer returned by getBuffer() only
+    refers to that block: setNumSamples() and getPair() re-point it without
+    allocating, which is why it must never be resized through setSize().
+*/
+class PlanarBuffer
+{
+public:
+    static constexpr size_t planarAlignment = 64;
+
+    PlanarBuffer() = default;
+
+    //The only call that allocates. Not while another thread uses the buffer.
+    void allocate(int numChannelsToAllocate, int maxSamples)
+    {
+        constexpr auto floatsPerLine = (int)(planarAlignment / sizeof(float));
+
+        numChannels = numChannelsToAllocate;
+        maxNumSamples = maxSamples;
+        stride = (maxSamples + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+
+        storage.allocate((size_t)(numChannels * stride + floatsPerLine), true);
+        channels.allocate((size_t)numChannels, true);
+
+        auto* first = juce::snapPointerToAlignment(storage.get(), planarAlignment);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            channels[channel] = first + channel * stride;
+
+        setNumSamples(maxSamples);
+    }
+
+    //Shortens or restores the view, within the allocated length.
+    void setNumSamples(int numSamples) noexcept
+    {
+        buffer.setDataToReferTo(channels.get(), numChannels, juce::jlimit(0, maxNumSamples, numSamples));
+    }
+
+    juce::AudioBuffer<float>& getBuffer() noexcept { return buffer; }
+    const juce::AudioBuffer<float>& getBuffer() const noexcept { return buffer; }
+
+    int getMaxNumSamples() const noexcept { return maxNumSamples; }
+    int getNumChannels() const noexcept { return numChannels; }
+    size_t getSizeInBytes() const noexcept { return (size_t)numChannels * (size_t)stride * sizeof(float); }
+
+    //Points dest at two channels of the current view, no copy. left == right gives a dual mono pair.
+    void getPair(int left, int right, juce::AudioBuffer<float>& dest) const noexcept
+    {
+        float* pair[] = { channels[left], channels[right] };
+        dest.setDataToReferTo(pair, 2, buffer.getNumSamples());
+    }
+
+private:
+    juce::HeapBlock<float> storage;
+    juce::HeapBlock<float*> channels;
+    juce::AudioBuffer<float> buffer;
+
+    int numChannels = 0;
+    int maxNumSamples = 0;
+    int stride = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlanarBuffer)
+};
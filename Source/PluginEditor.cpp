@@ -14,41 +14,117 @@ ChorusFindAudioProcessorEditor::ChorusFindAudioProcessorEditor (ChorusFindAudioP
     : AudioProcessorEditor (&p), audioProcessor (p), apvts(valueTree)
     , procState(state)
     , sldChorusAmount(juce::Slider::SliderStyle::LinearHorizontal, juce::Slider::TextEntryBoxPosition::NoTextBox)
+    , sldCaptureSeconds(juce::Slider::SliderStyle::LinearHorizontal, juce::Slider::TextEntryBoxPosition::TextBoxRight)
+    , sldWindowBars(juce::Slider::SliderStyle::LinearHorizontal, juce::Slider::TextEntryBoxPosition::TextBoxRight)
     , btnEval(text::textEval)
+    , btnExport(text::textExport)
+    , tglStreamUpload(text::textStreamUpload)
+    , tglBarAligned(text::textBarAligned)
+    , tglDiagnostics(text::textDiagnostics)
     , lblSoloText(text::textSolo, text::textSolo)
     , lblChorusText(text::textChorus, text::textChorus)
+    , lblWindowText(text::textWindow, text::textWindow)
+    , lblBackendText(text::textBackend, text::textBackend)
+    , lblModeText(text::textMode, text::textMode)
+    , lblServerText(text::textServer, text::textServer)
+    , viewWaveform(p.getPeakFifo(), p.getStereoMeter())
+    , paramReadMode(valueTree.getRawParameterValue(parameters::mode.id))
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize(400, 200);
+    setSize(400, 375);
 
     //Slider Components
     addAndMakeVisible(sldChorusAmount);
     sldChorusAmount.setEnabled(false);
 
+    sldCaptureSeconds.setTextValueSuffix(" s");
+    addAndMakeVisible(sldCaptureSeconds);
+    addAndMakeVisible(lblWindowText);
+
+    //Backend selector. Items must exist before the attachment is created.
+    cmbBackend.addItemList(parameters::backend.choices, 1);
+    addAndMakeVisible(cmbBackend);
+    addAndMakeVisible(lblBackendText);
+
+    cmbMode.addItemList(parameters::mode.choices, 1);
+    cmbMode.onChange = [this]
+    {
+        updateEnableEval();
+        updateStatusText();
+    };
+    addAndMakeVisible(cmbMode);
+    addAndMakeVisible(lblModeText);
+
+    //Only used by the HTTP backend.
+    addAndMakeVisible(tglStreamUpload);
+    cmbUploadFormat.addItemList(parameters::uploadFormat.choices, 1);
+    cmbUploadFormat.setTooltip("Request body format, the server can decline it");
+    addAndMakeVisible(cmbUploadFormat);
+
+    //Window length in bars of the host tempo, replaces the capture length while the host plays.
+    addAndMakeVisible(tglBarAligned);
+    sldWindowBars.setTextValueSuffix(" bars");
+    addAndMakeVisible(sldWindowBars);
+
+    edServerUrl.setText(audioProcessor.getApiUrl(), juce::NotificationType::dontSendNotification);
+    edServerUrl.onReturnKey = [this] { commitServerUrl(); };
+    edServerUrl.onFocusLost = [this] { commitServerUrl(); };
+    addAndMakeVisible(edServerUrl);
+    addAndMakeVisible(lblServerText);
+
     //Evaluate Button
     btnEval.addListener(this);
     addAndMakeVisible(btnEval);
 
+    //Timeline export, enabled once an offline render has produced one.
+    btnExport.onClick = [this] { exportTimeline(); };
+    addAndMakeVisible(btnExport);
+
+    addAndMakeVisible(viewWaveform);
+
+    //Performance counters of this instance, hidden until asked for.
+    tglDiagnostics.onClick = [this] { showDiagnostics(tglDiagnostics.getToggleState()); };
+    addAndMakeVisible(tglDiagnostics);
+
+    pnlDiagnostics.onReset = [this] { audioProcessor.resetTelemetry(); };
+    addChildComponent(pnlDiagnostics);
+
     //Status Label
     lblStatus.setText("Ready...",juce::NotificationType::dontSendNotification);
     addAndMakeVisible(lblStatus);
 
+    //Result cache counters, shared by all instances.
+    lblCacheStats.setFont(juce::Font(12.0f));
+    addAndMakeVisible(lblCacheStats);
+
     addAndMakeVisible(lblSoloText);
     addAndMakeVisible(lblChorusText);
 
     addAndMakeVisible(lblSoloPct);
     addAndMakeVisible(lblChorusPct);
 
-    updatePcts(sldChorusAmount.getValue());
+    //The attachment moves the slider on the message thread whenever the parameter changes.
+    sldChorusAmount.onValueChange = [this] { updatePcts((float)sldChorusAmount.getValue()); };
 
     attchChorusAmount.reset(new juce::AudioProcessorValueTreeState::SliderAttachment(apvts, parameters::chorusAmount.id, sldChorusAmount));
+    attchCaptureSeconds.reset(new juce::AudioProcessorValueTreeState::SliderAttachment(apvts, parameters::captureSeconds.id, sldCaptureSeconds));
+    attchBackend.reset(new juce::AudioProcessorValueTreeState::ComboBoxAttachment(apvts, parameters::backend.id, cmbBackend));
+    attchMode.reset(new juce::AudioProcessorValueTreeState::ComboBoxAttachment(apvts, parameters::mode.id, cmbMode));
+    attchStreamUpload.reset(new juce::AudioProcessorValueTreeState::ButtonAttachment(apvts, parameters::streamUpload.id, tglStreamUpload));
+    attchBarAligned.reset(new juce::AudioProcessorValueTreeState::ButtonAttachment(apvts, parameters::barAligned.id, tglBarAligned));
+    attchWindowBars.reset(new juce::AudioProcessorValueTreeState::SliderAttachment(apvts, parameters::windowBars.id, sldWindowBars));
+    attchUploadFormat.reset(new juce::AudioProcessorValueTreeState::ComboBoxAttachment(apvts, parameters::uploadFormat.id, cmbUploadFormat));
 
-    startTimer(100);
+    //Everything else is updated when it changes, nothing is polled.
+    updatePcts((float)sldChorusAmount.getValue());
+    changeListenerCallback(nullptr);
+    audioProcessor.addChangeListener(this);
 }
 
 ChorusFindAudioProcessorEditor::~ChorusFindAudioProcessorEditor()
 {
+    audioProcessor.removeChangeListener(this);
 }
 
 //==============================================================================
@@ -66,26 +142,93 @@ void ChorusFindAudioProcessorEditor::resized()
 
     btnEval.setBounds(20, 30, 150, 30);
 
+    lblWindowText.setBounds(190, 10, 100, 20);
+    sldCaptureSeconds.setBounds(190, 30, 190, 30);
+
+    lblBackendText.setBounds(190, 60, 90, 20);
+    cmbBackend.setBounds(190, 80, 90, 24);
+
+    lblModeText.setBounds(290, 60, 90, 20);
+    cmbMode.setBounds(290, 80, 90, 24);
+
+    tglStreamUpload.setBounds(190, 110, 100, 24);
+    cmbUploadFormat.setBounds(290, 110, 90, 24);
+
+    tglBarAligned.setBounds(20, 140, 150, 24);
+    sldWindowBars.setBounds(190, 140, 190, 24);
+
+    lblServerText.setBounds(20, 170, 60, 24);
+    edServerUrl.setBounds(80, 170, 300, 24);
+
     lblStatus.setBounds(20,80,150,30);
+    lblCacheStats.setBounds(20, 108, 160, 24);
 
-    sldChorusAmount.setBounds(20, 120, 300, 30);
+    sldChorusAmount.setBounds(20, 200, 300, 30);
+    btnExport.setBounds(320, 203, 60, 24);
     
-    lblSoloText.setBounds(20, 140, 100, 30);
-    lblSoloPct.setBounds(20,160,100,30);
+    lblSoloText.setBounds(20, 220, 100, 30);
+    lblSoloPct.setBounds(20,240,100,30);
     
-    lblChorusText.setBounds(280, 140, 100, 30);
-    lblChorusPct.setBounds(280, 160, 100, 30);
+    lblChorusText.setBounds(280, 220, 100, 30);
+    lblChorusPct.setBounds(280, 240, 100, 30);
+
+    tglDiagnostics.setBounds(140, 243, 120, 24);
+
+    viewWaveform.setBounds(10, 285, 380, 80);
+    pnlDiagnostics.setBounds(10, 370, 380, 110);
+}
+
+void ChorusFindAudioProcessorEditor::showDiagnostics(bool shouldShow)
+{
+    pnlDiagnostics.setVisible(shouldShow);
+    setSize(400, shouldShow ? 485 : 375);
+
+    if (shouldShow)
+    {
+        pnlDiagnostics.setSnapshot(audioProcessor.getTelemetry());
+        startTimer(display::diagnosticsIntervalMs);
+    }
+    else
+    {
+        stopTimer();
+    }
 }
 
 void ChorusFindAudioProcessorEditor::buttonClicked(juce::Button*)
 {    
-    procState.goToNextState();
+    audioProcessor.requestEvaluation();
     updateEnableEval();
 }
 
+bool ChorusFindAudioProcessorEditor::isContinuous() const
+{
+    return (int)paramReadMode->load() == DetectionMode::CONTINUOUS;
+}
+
+bool ChorusFindAudioProcessorEditor::isTimeline() const
+{
+    return (int)paramReadMode->load() == DetectionMode::TIMELINE;
+}
+
+void ChorusFindAudioProcessorEditor::exportTimeline()
+{
+    exportChooser = std::make_unique<juce::FileChooser>("Export chorus timeline",
+        juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("ChorusTimeline.csv"), "*.csv");
+
+    exportChooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting,
+        [this](const juce::FileChooser& chooser)
+        {
+            const auto file = chooser.getResult();
+
+            if (file != juce::File() && ! audioProcessor.exportTimeline(file))
+                juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Error", "Could not write " + file.getFullPathName());
+        });
+}
+
 void ChorusFindAudioProcessorEditor::updateEnableEval()
 {
-    if (procState.getPluginState() == PluginState::READY)
+    //The continuous mode updates on its own, there is nothing to trigger.
+    if (procState.getPluginState() == PluginState::READY && ! isContinuous())
     {
         btnEval.setEnabled(true);
     }
@@ -102,7 +245,16 @@ void ChorusFindAudioProcessorEditor::updateStatusText()
     switch (procState.getPluginState())
     {
     case PluginState::READY:
-        statusText = "Ready...";
+        if (isContinuous())
+            statusText = "Tracking live...";
+        else if (isTimeline() && audioProcessor.getTimelineNumPending() > 0)
+            statusText = "Analysing render (" + juce::String(audioProcessor.getTimelineNumPending()) + ")...";
+        else if (isTimeline())
+            statusText = "Timeline: " + juce::String(audioProcessor.getTimelineNumHops()) + " hops";
+        else if (audioProcessor.isAnalysing())
+            statusText = "Ready, still calculating the last window...";
+        else
+            statusText = "Ready...";
         break;
     case PluginState::LISTENING:
         statusText = "Listening to audio...";
@@ -130,9 +282,35 @@ void ChorusFindAudioProcessorEditor::updatePcts(float chorusPct)
     lblChorusPct.setText(chorusPctText, juce::NotificationType::dontSendNotification);
 }
 
-void ChorusFindAudioProcessorEditor::timerCallback()
+void ChorusFindAudioProcessorEditor::commitServerUrl()
+{
+    const auto url = edServerUrl.getText().trim();
+
+    if (url.isNotEmpty() && url != audioProcessor.getApiUrl())
+        audioProcessor.setApiUrl(url);
+}
+
+void ChorusFindAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster*)
 {
     updateEnableEval();
     updateStatusText();
-    updatePcts(sldChorusAmount.getValue());
+    updateCacheStats();
+
+    btnExport.setEnabled(audioProcessor.getTimelineNumHops() > 0);
+
+    //Multichannel inputs: the amount of every channel pair, the slider shows their level-weighted average.
+    sldChorusAmount.setTooltip(audioProcessor.getPairSummary());
+}
+
+void ChorusFindAudioProcessorEditor::timerCallback()
+{
+    pnlDiagnostics.setSnapshot(audioProcessor.getTelemetry());
+}
+
+void ChorusFindAudioProcessorEditor::updateCacheStats()
+{
+    const auto stats = audioProcessor.getCacheStats();
+
+    lblCacheStats.setText("Cache: " + juce::String(stats.hits) + " hits, " + juce::String(stats.misses) + " misses",
+                          juce::NotificationType::dontSendNotification);
 }
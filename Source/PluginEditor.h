@@ -12,12 +12,15 @@
 #include "PluginProcessor.h"
 #include "Config.h"
 #include "State.h"
+#include "DiagnosticsPanel.h"
+#include "WaveformView.h"
 
 //==============================================================================
 /**
 */
 class ChorusFindAudioProcessorEditor  : public juce::AudioProcessorEditor
     ,public juce::Button::Listener
+    ,public juce::ChangeListener
     ,public juce::Timer
 {
 public:
@@ -38,25 +41,74 @@ private:
 
     //GUI components
     juce::Slider sldChorusAmount;
+    juce::Slider sldCaptureSeconds;
+    juce::Slider sldWindowBars;
 
     juce::TextButton btnEval;
+    juce::TextButton btnExport;
+
+    juce::ComboBox cmbBackend;
+    juce::ComboBox cmbMode;
+    juce::ComboBox cmbUploadFormat;
+
+    juce::ToggleButton tglStreamUpload;
+    juce::ToggleButton tglBarAligned;
+    juce::ToggleButton tglDiagnostics;
+
+    juce::TextEditor edServerUrl;
 
     juce::Label lblStatus;
+    juce::Label lblCacheStats;
     juce::Label lblSoloText;
     juce::Label lblChorusText;
 
     juce::Label lblSoloPct;
     juce::Label lblChorusPct;
 
+    juce::Label lblWindowText;
+    juce::Label lblBackendText;
+    juce::Label lblModeText;
+    juce::Label lblServerText;
+
+    //Needed for the tooltips of this window.
+    juce::TooltipWindow tooltips{ this };
+
+    //Live input below the main controls.
+    WaveformView viewWaveform;
+
+    //Shown below the waveform when tglDiagnostics is on.
+    DiagnosticsPanel pnlDiagnostics;
+    void showDiagnostics(bool shouldShow);
+
     //Parameter-Component attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attchChorusAmount;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attchCaptureSeconds;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> attchBackend;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> attchMode;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> attchStreamUpload;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> attchBarAligned;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attchWindowBars;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> attchUploadFormat;
+
+    std::atomic<float>* paramReadMode = nullptr;
+    bool isContinuous() const;
+    bool isTimeline() const;
+
+    std::unique_ptr<juce::FileChooser> exportChooser;
+    void exportTimeline();
 
     void buttonClicked(juce::Button*) override;
     void updateEnableEval();
     void updateStatusText();
+    void updateCacheStats();
 
     void updatePcts(float chorusPct);
+    void commitServerUrl();
+
+    //Processor status changed: state, timeline or cache counters.
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
 
+    //Only runs while the diagnostics panel is shown.
     void timerCallback() override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChorusFindAudioProcessorEditor)
@@ -9,9 +9,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
-//==============================================================================
-//Initialization of static variables.
-juce::ThreadPool ChorusFindAudioProcessor::sharedThredPool{};
 //==============================================================================
 ChorusFindAudioProcessor::ChorusFindAudioProcessor()
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -27,12 +24,36 @@ ChorusFindAudioProcessor::ChorusFindAudioProcessor()
     , parameters(*this, nullptr, juce::Identifier("APVTS"), createParameterLayout())
     , paramReadChorusAmount(parameters.getRawParameterValue(parameters::chorusAmount.id))
     , paramChorusAmount(parameters.getParameter(parameters::chorusAmount.id))
+    , paramReadCaptureSeconds(parameters.getRawParameterValue(parameters::captureSeconds.id))
+    , paramReadBackend(parameters.getRawParameterValue(parameters::backend.id))
+    , paramReadMode(parameters.getRawParameterValue(parameters::mode.id))
+    , paramReadStreamUpload(parameters.getRawParameterValue(parameters::streamUpload.id))
+    , paramReadBarAligned(parameters.getRawParameterValue(parameters::barAligned.id))
+    , paramReadWindowBars(parameters.getRawParameterValue(parameters::windowBars.id))
+    , paramReadUploadFormat(parameters.getRawParameterValue(parameters::uploadFormat.id))
 {
-    
+    streamingAnalyser.onEstimate = [this](float estimate)
+    {
+        results.push({ EvaluationResult::Kind::live, 0, estimate });
+    };
+
+    const auto metricsPath = juce::SystemStats::getEnvironmentVariable(metrics::fileVariable, {});
+
+    if (juce::File::isAbsolutePath(metricsPath))
+        metricsFile = juce::File(metricsPath);
+
+    startTimer(capture::dispatchIntervalMs);
 }
 
 ChorusFindAudioProcessor::~ChorusFindAudioProcessor()
 {
+    stopTimer();
+
+    //Aborts a streamed upload and waits for running jobs, they all reference this instance.
+    jobs.cancelAll();
+    analysisClient.cancel(true);
+    daemonClient.cancel(true);
+    streamingAnalyser.stopThread(2000);
 }
 
 //==============================================================================
@@ -102,13 +123,71 @@ void ChorusFindAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 {
     // Use this method as the place to do any pre-playback
     // initialisation that you need..
-    bufListen.clear();
+
+    //The analysers, the analysis and upload jobs read the ring, and the jobs and requests in flight hold
+    //on to the pair analyses, so all of them must be stopped while those are reallocated.
+    streamingAnalyser.stopThread(2000);
+    offlineAnalyser.end(ringCapture.getTotalWritten());
+    cancelEvaluationJobs();
+
+    //Every input channel is captured. A mono input is repeated into the second channel.
+    numCaptureChannels = juce::jlimit(2, capture::maxChannels, getTotalNumInputChannels());
+
+    //Chorus cues sit well below analysis::targetRate / 2, the ring and everything after it run at the lower rate.
+    decimator.prepare(sampleRate, analysis::targetRate, numCaptureChannels);
+    decimatorSliceSize = juce::jmax(1, samplesPerBlock);
+    bufDecimated.setSize(numCaptureChannels, decimator.getMaxOutputSamples(decimatorSliceSize));
+    inputPosition = 0;
+
+    const double analysisRate = getAnalysisRate();
+
+    //The ring holds the longest selectable window plus some headroom for the reader, and the time a
+    //finished capture may wait for a pool buffer. Analyses never hold it up, the window is copied first.
+    const int maxWindowSamples = (int)std::ceil(parameters::captureSeconds.maxValue * analysisRate);
+    const double waitSeconds = capture::headroomSeconds + capture::poolWaitMs / 1000.0;
+    const int headroomSamples = juce::jmax(bufDecimated.getNumSamples(), (int)std::ceil(waitSeconds * analysisRate));
+
+    ringCapture.prepare(numCaptureChannels, maxWindowSamples + headroomSamples);
+
+    auto pairs = channelpairs::fromLayout(getChannelLayoutOfBus(true, 0));
+
+    //No input bus, or only LFE: analyse the first two capture channels.
+    if (pairs.isEmpty())
+        pairs.add({ 0, 1, "L/R" });
+
+    pairAnalyses.clear();
+
+    for (const auto& pair : pairs)
+    {
+        auto* analysis = pairAnalyses.add(new PairAnalysis());
+        analysis->channels = pair;
+        analysis->detector.prepare(analysisRate);
+
+        if (chorusModel->isLoaded())
+            analysis->model.prepare(*chorusModel, analysisRate, maxWindowSamples);
+    }
+
+    frontLeft = pairs.getFirst().left;
+    frontRight = pairs.getFirst().right;
+    stereoMeter.prepare(analysisRate);
+    chunkedUploader.prepare(2, analysisRate);
+
+    transport.prepare(sampleRate);
+    peaks.prepare(sampleRate);
+
+    streamingAnalyser.prepare(analysisRate);
+    streamingAnalyser.startThread(juce::Thread::Priority::low);
+    jobs.resume();
 }
 
 void ChorusFindAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    streamingAnalyser.stopThread(2000);
+
+    //Hosts release resources when an offline render is done.
+    offlineAnalyser.end(ringCapture.getTotalWritten());
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -118,12 +197,10 @@ bool ChorusFindAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    //Anything from mono up to 7.1.4, named or discrete. The audio passes through untouched.
+    const int numChannels = layouts.getMainOutputChannelSet().size();
+
+    if (numChannels < 1 || numChannels > capture::maxChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -139,6 +216,8 @@ bool ChorusFindAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 
 void ChorusFindAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    CHORUSFIND_REALTIME_SCOPE
+    const Telemetry::ScopedBlockTimer blockTimer(telemetry, buffer.getNumSamples(), getSampleRate());
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -158,148 +237,763 @@ void ChorusFindAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, j
     // the samples and the outer loop is handling the channels.
     // Alternatively, you can process the samples with the channels
     // interleaved by keeping the same state.
-    if (currState.getPluginState() == PluginState::READY)
+    const auto blockStart = ringCapture.getTotalWritten();
+    pushToCapture(buffer, totalNumInputChannels);
+    peaks.push(buffer, totalNumInputChannels);
+
+    juce::Optional<juce::AudioPlayHead::PositionInfo> position;
+
+    if (auto* playHead = getPlayHead())
+        position = playHead->getPosition();
+
+    transport.update(position, inputPosition, buffer.getNumSamples());
+    inputPosition += buffer.getNumSamples();
+
+    if ((int)paramReadMode->load() == DetectionMode::TIMELINE)
     {
-        
+        if (isNonRealtime())
+            processOfflineBlock(position, blockStart, buffer.getNumSamples());
+        else
+            followTimeline(position);
     }
-    else if (currState.getPluginState() == PluginState::LISTENING)
+
+    streamingAnalyser.setActive((int)paramReadMode->load() == DetectionMode::CONTINUOUS);
+
+    //Nothing here blocks: commands come in through a lock-free queue, the state only
+    //moves forward with compare-and-swap, and workers are launched by the message thread.
+    Command command;
+
+    while (commands.pop(command))
     {
-        juce::Logger::writeToLog("Listening");
-        if (listenWriteIndex + buffer.getNumSamples() > bufListen.getNumSamples())
+        if (command == Command::evaluate && currState.getPluginState() == PluginState::READY)
         {
-            for (int channel = 0; channel < totalNumInputChannels; ++channel)
+            //Fix the window now. Bar-aligned windows end on the latest bar line that has whole bars
+            //of continuous playback before it. Otherwise the window ends here if the ring already
+            //holds enough audio, or once enough has been captured. A streamed window starts here,
+            //so its chunks go out while it is recorded.
+            const int maxWindowSamples = (int)(parameters::captureSeconds.maxValue * getSampleRate());
+            juce::int64 endPosition = 0;
+            int windowSamples = 0;
+
+            const bool barAligned = paramReadBarAligned->load() >= 0.5f
+                                 && transport.findBarWindow((int)paramReadWindowBars->load(), maxWindowSamples, endPosition, windowSamples);
+
+            if (barAligned)
             {
-                auto* channelData = buffer.getWritePointer(channel);
-                bufListen.copyFrom(channel, listenWriteIndex, buffer, channel, 0, bufListen.getNumSamples()-listenWriteIndex);
+                //Bars are found at the input rate. The filter delays the ring by its latency.
+                endPosition = endPosition / decimator.getFactor() + decimator.getLatency();
+                windowSamples /= decimator.getFactor();
+                logger->log(LogLevel::info, "Bar-aligned window of %g samples", windowSamples);
             }
-
-            currState.goToNextState();
-            juce::Logger::writeToLog("Listening Completed");
-            listenWriteIndex = 0;
-        }
-        else
-        {
-            for (int channel = 0; channel < totalNumInputChannels; ++channel)
+            else
             {
-                auto* channelData = buffer.getWritePointer(channel);
-                bufListen.copyFrom(channel, listenWriteIndex, buffer, channel, 0, buffer.getNumSamples());
+                if (paramReadBarAligned->load() >= 0.5f)
+                    logger->log(LogLevel::info, "No host tempo or transport stopped, using the capture length instead of bars.");
+
+                windowSamples = (int)(paramReadCaptureSeconds->load() * getAnalysisRate());
             }
 
-            listenWriteIndex += buffer.getNumSamples();
+            //A bar-aligned window lies in the past already, streaming it would only be slower than one upload.
+            const bool streamed = ! barAligned
+                               && (int)paramReadBackend->load() == DetectionBackend::HTTP
+                               && paramReadStreamUpload->load() >= 0.5f;
+
+            if (streamed)
+                endPosition = ringCapture.getTotalWritten() + windowSamples;
+            else if (! barAligned)
+                endPosition = juce::jmax(ringCapture.getTotalWritten(), (juce::int64)windowSamples);
+
+            captureWindowSamples = windowSamples;
+            captureEndPosition = endPosition;
+            streamingUploadActive = streamed;
+
+            //Everything above is published together with the new state.
+            ++evaluationId;
+            currState.goToNextState(PluginState::READY);
+            logger->log(LogLevel::info, "Listening");
         }
-        
     }
-    else if (currState.getPluginState() == PluginState::CALCULATING)
+
+    if (currState.getPluginState() == PluginState::LISTENING && ringCapture.getTotalWritten() >= captureEndPosition)
     {
-        juce::Logger::writeToLog("Calculating");
+        currState.goToNextState(PluginState::LISTENING);
+        logger->log(LogLevel::info, "Listening Completed");
+    }
+}
 
-        //Call API from another thread.
+void ChorusFindAudioProcessor::pushToCapture(const juce::AudioBuffer<float>& buffer, int numInputChannels)
+{
+    //Hosts may send more than they announced in prepareToPlay, so go in slices that fit bufDecimated.
+    for (int start = 0; start < buffer.getNumSamples(); start += decimatorSliceSize)
+    {
+        const int numSamples = juce::jmin(decimatorSliceSize, buffer.getNumSamples() - start);
+        const int numDecimated = decimator.process(buffer, start, numSamples, numInputChannels, bufDecimated);
 
-        sharedThredPool.addJob([&]()
-            {
-                float api_result = callChorusDetectionAPI(getSampleRate(),24);
-                paramChorusAmount->setValueNotifyingHost(api_result);
-                
-                juce::Logger::writeToLog("Calculation Completed.");
-                currState.goToNextState();
-            });
-        currState.goToNextState();
-        juce::Logger::writeToLog("Went to next state");
+        ringCapture.push(bufDecimated, numCaptureChannels, numDecimated);
+        stereoMeter.process(bufDecimated.getReadPointer(frontLeft), bufDecimated.getReadPointer(frontRight), numDecimated);
     }
-    else if (currState.getPluginState() == PluginState::BACKGROUND)
+}
+
+void ChorusFindAudioProcessor::processOfflineBlock(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, juce::int64 blockStart, int numSamples)
+{
+    //Offline renders are not real-time, advance() may wait for a free analysis slot.
+    //blockStart is a ring position, numSamples counts host samples.
+    const auto written = ringCapture.getTotalWritten();
+
+    juce::int64 hostSample = -1;
+
+    if (position.hasValue())
+        if (const auto timeInSamples = position->getTimeInSamples())
+            hostSample = *timeInSamples;
+
+    //A new render, or a jump inside one, starts a new timeline.
+    if (! offlineAnalyser.isActive() || (hostSample >= 0 && hostSample != offlineExpectedHostSample))
     {
+        offlineAnalyser.end(blockStart);
+        offlineAnalyser.begin(getAnalysisRate(), hostSample >= 0 ? hostSample / getSampleRate() : 0.0, blockStart);
+        logger->log(LogLevel::info, "Offline timeline started at %g s", hostSample >= 0 ? hostSample / getSampleRate() : 0.0);
+    }
+
+    offlineExpectedHostSample = hostSample >= 0 ? hostSample + numSamples : -1;
+    offlineAnalyser.advance(written);
+}
+
+void ChorusFindAudioProcessor::followTimeline(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position)
+{
+    if (! position.hasValue() || ! position->getIsPlaying())
+        return;
+
+    const auto seconds = position->getTimeInSeconds();
+    float value = 0.0f;
 
+    //Hosts in automation write mode record these changes.
+    if (seconds && timeline.tryGetValueAt(*seconds, value) && value != lastTimelineValue)
+    {
+        lastTimelineValue = value;
+        results.push({ EvaluationResult::Kind::live, 0, value });
     }
-    
 }
 
-float ChorusFindAudioProcessor::callChorusDetectionAPI(int sampleRate, int bitsPerSample)
+//==============================================================================
+void ChorusFindAudioProcessor::requestEvaluation()
+{
+    if (! commands.push(Command::evaluate))
+        logger->log(LogLevel::warning, "Command queue is full, evaluation request dropped.");
+}
+
+ResultCache::Stats ChorusFindAudioProcessor::getCacheStats() const
+{
+    return resultCache->getStats();
+}
+
+int ChorusFindAudioProcessor::getTimelineNumHops() const
+{
+    return timeline.getNumHops();
+}
+
+int ChorusFindAudioProcessor::getTimelineNumPending() const
+{
+    return offlineAnalyser.getNumPending();
+}
+
+bool ChorusFindAudioProcessor::exportTimeline(const juce::File& file) const
+{
+    return timeline.exportCsv(file);
+}
+
+Telemetry::Snapshot ChorusFindAudioProcessor::getTelemetry() const
 {
-    juce::File tempFile = juce::File::createTempFile("temp_audio.wav");    
-    saveAudioBufferAsWav(bufListen, tempFile,sampleRate,bitsPerSample);
+    auto snapshot = telemetry.getSnapshot();
+
+    const auto written = ringCapture.getTotalWritten();
+    const int capacity = ringCapture.getCapacity();
 
-    juce::URL url(api::url);
-    
-    auto stream = std::make_unique<juce::FileInputStream>(tempFile);
+    if (capacity > 0)
+        snapshot.ringFill = (float)juce::jmin(written, (juce::int64)capacity) / (float)capacity;
 
-    try
+    //Share of the evaluated window captured so far.
+    if (currState.getPluginState() == PluginState::LISTENING && captureWindowSamples > 0)
     {
-        if (stream->openedOk())
+        const auto missing = juce::jmax((juce::int64)0, captureEndPosition - written);
+        snapshot.windowFill = juce::jlimit(0.0f, 1.0f, 1.0f - (float)missing / (float)captureWindowSamples);
+    }
+
+    snapshot.commandQueueDepth = commands.getNumReady();
+    snapshot.resultQueueDepth = results.getNumReady();
+    snapshot.jobQueueDepth = jobs.getNumQueuedJobs();
+    snapshot.offlinePending = offlineAnalyser.getNumPending();
+    return snapshot;
+}
+
+void ChorusFindAudioProcessor::resetTelemetry()
+{
+    telemetry.reset();
+}
+
+void ChorusFindAudioProcessor::writeMetrics()
+{
+    const auto now = juce::Time::getMillisecondCounter();
+
+    if (metricsFile == juce::File() || now - lastMetricsMs < (juce::uint32)metrics::fileIntervalMs)
+        return;
+
+    lastMetricsMs = now;
+
+    //The snapshot is taken here, only the file write goes to a worker. A write still waiting is replaced.
+    jobs.schedule(metricsJob, JobScheduler::Priority::background, [file = metricsFile, line = getTelemetry().toJson(telemetry.getInstanceId())]()
+        {
+            Telemetry::appendToMetricsFile(file, line);
+        });
+}
+
+void ChorusFindAudioProcessor::timerCallback()
+{
+    const int id = evaluationId.load();
+
+    //A streamed upload starts as soon as the audio thread has fixed the window.
+    if (currState.getPluginState() != PluginState::READY && streamingUploadActive && id != launchedEvaluationId)
+    {
+        launchedEvaluationId = id;
+        scheduleJob(streamingUploadJob, JobScheduler::Priority::normal, id, [this, id]() { runStreamingUpload(id); });
+    }
+
+    //A finished capture is copied out of the ring straight away, even while the previous window is still
+    //being analysed, so the ring never has to outlast an analysis or a request.
+    if (currState.getPluginState() == PluginState::CALCULATING && id != launchedEvaluationId && capturedEvaluationId != id)
+        captureWindow(id);
+
+    //Windows are analysed one at a time, a copied window waits for the previous analysis.
+    if (analysingEvaluationId.load() == 0 && currState.getPluginState() == PluginState::CALCULATING)
+    {
+        if (id == launchedEvaluationId)
+        {
+            //Streamed, the upload is running already.
+            currState.goToNextState(PluginState::CALCULATING);
+        }
+        else if (capturedEvaluationId == id && currState.goToNextState(PluginState::CALCULATING))
+        {
+            launchedEvaluationId = id;
+            launchAnalysis(id, std::move(capturedWindow));
+        }
+    }
+
+    applyResults();
+    notifyStatusChanges();
+    writeMetrics();
+}
+
+void ChorusFindAudioProcessor::captureWindow(int id)
+{
+    //A window buffer is checked out here rather than on a worker, so no worker blocks while other
+    //instances' jobs still hold the pool. Retried every tick until poolWaitMs.
+    const auto now = juce::Time::getMillisecondCounter();
+
+    if (checkoutEvaluationId != id)
+    {
+        checkoutEvaluationId = id;
+        checkoutDeadline = now + (juce::uint32)capture::poolWaitMs;
+    }
+
+    auto window = capturePool->checkout(numCaptureChannels, getCaptureWindowLength());
+
+    if (window == nullptr && (int)(checkoutDeadline - now) > 0)
+        return;
+
+    //The window could not be read, or what the buffer holds is an earlier window or another instance's
+    //audio. Either way there is nothing to analyse.
+    if (window == nullptr || ! snapshotCaptureWindow(*window))
+    {
+        logger->log(LogLevel::error, window == nullptr ? "Capture pool budget exhausted, evaluation abandoned."
+                                                       : "Capture window was overwritten before it could be read, evaluation abandoned.");
+
+        if (currState.goToNextState(PluginState::CALCULATING))
+            abandonEvaluation(id);
+
+        return;
+    }
+
+    capturedWindow = std::move(window);
+    capturedEvaluationId = id;
+}
+
+void ChorusFindAudioProcessor::notifyStatusChanges()
+{
+    //Nobody listens without an editor.
+    if (getActiveEditor() == nullptr)
+        return;
+
+    const auto stats = resultCache->getStats();
+    const StatusStamp status{ currState.getPluginState(), getTimelineNumHops(), getTimelineNumPending(), stats.hits, stats.misses, isAnalysing() };
+
+    if (status != lastStatus)
+    {
+        lastStatus = status;
+        sendChangeMessage();
+    }
+}
+
+bool ChorusFindAudioProcessor::scheduleJob(JobKey key, JobScheduler::Priority priority, int id, std::function<void()> job)
+{
+    //Without a worker the evaluation could never finish.
+    if (jobs.schedule(key, priority, std::move(job)))
+        return true;
+
+    logger->log(LogLevel::error, "Job queue is full, evaluation abandoned.");
+    abandonEvaluation(id);
+    return false;
+}
+
+void ChorusFindAudioProcessor::cancelEvaluationJobs()
+{
+    jobs.cancelAll();
+    analysisClient.cancel(true);
+    daemonClient.cancel(true);
+
+    //A window copied out of the old ring does not match the rebuilt pairs, its evaluation ends below.
+    if (capturedWindow != nullptr && capturedEvaluationId == evaluationId.load())
+        currState.goToNextState(PluginState::CALCULATING);
+
+    capturedWindow.reset();
+
+    //A streamed upload finishes itself when aborted, an analysis job or a request does not.
+    const int analysing = analysingEvaluationId.load();
+
+    if (analysing != 0)
+        abandonEvaluation(analysing);
+
+    const int current = evaluationId.load();
+
+    if (current != analysing && currState.getPluginState() == PluginState::BACKGROUND)
+        abandonEvaluation(current);
+}
+
+void ChorusFindAudioProcessor::launchAnalysis(int id, CapturePool::Lease window)
+{
+    logger->log(LogLevel::info, "Calculating");
+    analysingEvaluationId = id;
+
+    const bool scheduled = scheduleJob(analysisJob, JobScheduler::Priority::high, id, [this, id, window]()
         {
-            url = url.withFileToUpload("audio", tempFile, "audio/wav");
-            std::unique_ptr<juce::InputStream> responseStream = url.createInputStream(juce::URL::InputStreamOptions(juce::URL::ParameterHandling::inAddress));
+            int backend = (int)paramReadBackend->load();
+
+            if (backend == DetectionBackend::MODEL && ! chorusModel->isLoaded())
+            {
+                logger->log(LogLevel::warning, "No chorus model loaded (" + chorusModel->getStatus().getErrorMessage() + "), using the native detector.");
+                backend = DetectionBackend::NATIVE;
+            }
 
-            juce::String response;
+            const auto& listen = window->getBuffer();
+            const auto fingerprint = ResultCache::computeFingerprint(listen, listen.getNumSamples(), getAnalysisRate(), getAnalyserIdentity(backend));
+            float cachedResult = 0.0f;
 
-            try
+            //The same passage was analysed before, by this or another instance.
+            if (resultCache->lookup(fingerprint, backend, cachedResult))
             {
-                response = responseStream->readEntireStreamAsString();
+                logger->log(LogLevel::info, "Cache hit, analysis skipped.");
+                finishEvaluation(id, cachedResult, fingerprint, backend);
+                return;
             }
-            catch(const std::exception& e)
+
+            //The HTTP and DAEMON backends finish asynchronously in onApiResult and onDaemonResult.
+            if (backend == DetectionBackend::HTTP)
             {
-                juce::Logger::writeToLog("Exception occurred: " + juce::String(e.what()));
-                juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon,
-                    "Error",
-                    "API is not accessible. Please make sure you are connected to the internet.");
-                return 0.5f;
+                callChorusDetectionAPI(id, fingerprint, (int)getAnalysisRate(), getUploadFormat(), window);
             }
-            
+            else if (backend == DetectionBackend::DAEMON)
+            {
+                callAnalysisDaemon(id, fingerprint, *window);
+            }
+            else
+            {
+                analysePairs(id, fingerprint, backend, window);
+            }
+        });
+
+    //The workers own the window, so the next capture can start while it is analysed.
+    if (scheduled && currState.goToNextState(PluginState::BACKGROUND))
+        logger->log(LogLevel::info, "Window handed off");
+}
+
+juce::uint64 ChorusFindAudioProcessor::getAnalyserIdentity(int backend) const
+{
+    //The backend itself is part of the cache key, this tells apart what computed the result within it.
+    switch (backend)
+    {
+    case DetectionBackend::MODEL:
+        return chorusModel->getIdentity();
+    case DetectionBackend::HTTP:
+        return (juce::uint64)analysisClient.getEndpoint().hashCode64();
+    case DetectionBackend::DAEMON:
+        return (juce::uint64)DaemonConnection::getDefaultFile().getFullPathName().hashCode64();
+    default:
+        return (juce::uint64)ChorusDetector::version;
+    }
+}
+
+void ChorusFindAudioProcessor::analysePairs(int id, juce::uint64 fingerprint, int backend, const CapturePool::Lease& window)
+{
+    //Worker thread, the window was copied when its capture ended. Every pair job holds the lease, so the window goes back
+    //to the pool when the last pair has finished. The next evaluation cannot start before that.
+    const auto startMs = juce::Time::getMillisecondCounterHiRes();
+    pairsRemaining = pairAnalyses.size();
+
+    //This worker takes the first pair itself, the others go to the pool. A full queue just means running it here.
+    for (int i = 1; i < pairAnalyses.size(); ++i)
+    {
+        const auto analyse = [this, i, id, fingerprint, backend, startMs, window]() { analysePair(i, id, fingerprint, backend, startMs, *window); };
+
+        if (! jobs.schedule(pairJob + i, JobScheduler::Priority::high, analyse))
+            analyse();
+    }
+
+    analysePair(0, id, fingerprint, backend, startMs, *window);
+}
+
+void ChorusFindAudioProcessor::analysePair(int index, int id, juce::uint64 fingerprint, int backend, double startMs, const PlanarBuffer& window)
+{
+    auto& analysis = *pairAnalyses.getUnchecked(index);
 
-            // Parse the JSON response
-            juce::var result = juce::JSON::parse(response);
+    juce::AudioBuffer<float> pair;
+    window.getPair(analysis.channels.left, analysis.channels.right, pair);
+
+    //Windows shorter than the model's convolutions span go to the detector.
+    float modelResult = 0.0f;
+
+    if (backend == DetectionBackend::MODEL && analysis.model.isPrepared() && analysis.model.run(pair, modelResult))
+        analysis.result = modelResult;
+    else
+        analysis.result = analysis.detector.analyse(pair, getAnalysisRate());
+
+    analysis.weight = 0.5f * (pair.getRMSLevel(0, 0, pair.getNumSamples()) + pair.getRMSLevel(1, 0, pair.getNumSamples()));
+
+    if (--pairsRemaining > 0)
+        return;
+
+    //Last pair: average the pairs by level, so a silent stem does not pull the amount down. A single channel
+    //such as the centre always reads as mono, so it would pull every immersive mix towards no chorus. It
+    //only counts when the layout has no real pair.
+    bool hasRealPair = false;
+
+    for (auto* other : pairAnalyses)
+        hasRealPair = hasRealPair || ! other->channels.isSingle();
+
+    float weightedSum = 0.0f;
+    float totalWeight = 0.0f;
+    float plainSum = 0.0f;
+    int numCounted = 0;
+
+    for (auto* other : pairAnalyses)
+    {
+        if (hasRealPair && other->channels.isSingle())
+            continue;
 
-            if (result.isObject())
+        weightedSum += other->weight * other->result;
+        totalWeight += other->weight;
+        plainSum += other->result;
+        ++numCounted;
+    }
+
+    float result = 0.0f;
+
+    if (totalWeight > 1.0e-6f)
+        result = weightedSum / totalWeight;
+    else if (numCounted > 0)
+        result = plainSum / (float)numCounted;
+
+    telemetry.addAnalysisTime(juce::Time::getMillisecondCounterHiRes() - startMs);
+
+    if (fingerprint != 0)
+        resultCache->store(fingerprint, backend, result);
+
+    finishEvaluation(id, result, fingerprint, backend);
+}
+
+juce::String ChorusFindAudioProcessor::getPairSummary() const
+{
+    juce::StringArray parts;
+
+    for (auto* analysis : pairAnalyses)
+    {
+        const float result = analysis->result.load();
+
+        if (result >= 0.0f)
+            parts.add(analysis->channels.name + " " + juce::String(juce::roundToInt(result * 100.0f)) + "%");
+    }
+
+    return parts.joinIntoString(", ");
+}
+
+void ChorusFindAudioProcessor::applyResults()
+{
+    EvaluationResult result;
+
+    while (results.pop(result))
+    {
+        if (result.kind == EvaluationResult::Kind::live)
+        {
+            //Skip tiny changes so the host is not flooded with automation.
+            if (std::abs(result.value - paramChorusAmount->getValue()) > 0.001f)
+                paramChorusAmount->setValueNotifyingHost(result.value);
+        }
+        else if (result.kind == EvaluationResult::Kind::abandoned)
+        {
+            //Only frees the state, so it never replaces an older result still waiting to be applied.
+            if (result.evaluationId > abandonedEvaluationId)
             {
-                juce::var resultValue = result.getProperty("result", 0.5f);
-
-                if (resultValue.isDouble())
-                {
-                    // Extract the floating-point value
-                    double floatValue = resultValue;
-                    DBG("Float value from server response: " << floatValue);
-                    return floatValue;
-                }
+                abandonedEvaluationId = result.evaluationId;
+                ++numEvaluationsAbandoned;
+                logger->log(LogLevel::info, "Evaluation ended without a result, chorus amount left unchanged.");
             }
+        }
+        else if (result.evaluationId > appliedEvaluationId && (! hasPendingResult || result.evaluationId > pendingResult.evaluationId))
+        {
+            //Older results still count once the next capture has started, anything newer replaces them.
+            pendingResult = result;
+            hasPendingResult = true;
+        }
+    }
+
+    const bool isCurrent = hasPendingResult && pendingResult.evaluationId == evaluationId.load();
+    const auto state = currState.getPluginState();
+
+    //A streamed upload can finish before the capture has, keep it until then.
+    if (hasPendingResult && ! (isCurrent && (state == PluginState::LISTENING || state == PluginState::CALCULATING)))
+    {
+        hasPendingResult = false;
+        appliedEvaluationId = pendingResult.evaluationId;
+        ++numResultsApplied;
+
+        paramChorusAmount->setValueNotifyingHost(pendingResult.value);
 
-            DBG("Response from server: " << response);
+        {
+            const juce::SpinLock::ScopedLockType sl(lastResultLock);
+            lastResult = { true, pendingResult.value, pendingResult.backend, pendingResult.fingerprint };
         }
+
+        //Unless the window was handed off and the plugin is ready already.
+        if (isCurrent)
+            currState.goToNextState(PluginState::BACKGROUND);
+
+        logger->log(LogLevel::info, "Calculation Completed. Chorus amount %g", pendingResult.value);
     }
-    catch (const std::exception& e)
+
+    //An evaluation without a result frees the state too, a streamed one only once its capture has ended.
+    if (abandonedEvaluationId == evaluationId.load() && currState.getPluginState() == PluginState::BACKGROUND)
+        currState.goToNextState(PluginState::BACKGROUND);
+}
+
+void ChorusFindAudioProcessor::runStreamingUpload(int id)
+{
+    float result = 0.0f;
+    const auto endPosition = captureEndPosition.load();
+
+    const auto chunkUrl = api::chunkUrlFor(analysisClient.getEndpoint());
+    const auto shouldAbort = [this]() { return jobs.isCancelled(); };
+    const int format = getUploadFormat();
+
+    if (! chunkedUploader.run(chunkUrl, ringCapture, endPosition - captureWindowSamples, endPosition, getAnalysisRate(), format, shouldAbort, result))
     {
-        // Handle any exceptions that occur
-        juce::Logger::writeToLog("Exception occurred: " +juce::String( e.what()));
-        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon,
-            "Error",
-            "API is not accessible. Please make sure you are connected to the internet.");
+        logger->log(LogLevel::error, "Streaming upload failed.");
+
+        //The capture has moved on, so the window cannot be streamed again. The next one uses the fallback.
+        if (chunkedUploader.getLastStatusCode() == 415 && useFallbackFormat(format, chunkedUploader.getAcceptedFormats()))
+            logger->log(LogLevel::warning, "Server does not accept " + UploadEncoder::getWireName(format)
+                                         + " chunks, next uploads use " + UploadEncoder::getWireName(getUploadFormat()));
+
+        abandonEvaluation(id);
+        return;
     }
+
+    finishEvaluation(id, result);
+}
+
+int ChorusFindAudioProcessor::getCaptureWindowLength() const
+{
+    return juce::jmin((int)captureWindowSamples, ringCapture.getCapacity());
+}
+
+bool ChorusFindAudioProcessor::snapshotCaptureWindow(PlanarBuffer& window)
+{
+    const int windowSamples = getCaptureWindowLength();
+    return ringCapture.copyRange(window.getBuffer(), captureEndPosition - windowSamples, windowSamples);
+}
+
+void ChorusFindAudioProcessor::finishEvaluation(int id, float result, juce::uint64 fingerprint, int backend)
+{
+    //Any worker thread. The message thread applies it in applyResults().
+    int expected = id;
+    analysingEvaluationId.compare_exchange_strong(expected, 0);
+
+    if (! results.push({ EvaluationResult::Kind::evaluation, id, result, fingerprint, backend }))
+        logger->log(LogLevel::warning, "Result queue is full, evaluation result dropped.");
+}
+
+void ChorusFindAudioProcessor::abandonEvaluation(int id)
+{
+    //Any thread except the audio thread. Goes through the queue like a result, so it is ordered with them.
+    int expected = id;
+    analysingEvaluationId.compare_exchange_strong(expected, 0);
+
+    if (! results.push({ EvaluationResult::Kind::abandoned, id }))
+        logger->log(LogLevel::warning, "Result queue is full, evaluation end dropped.");
 }
 
-void ChorusFindAudioProcessor::saveAudioBufferAsWav(const juce::AudioBuffer<float>& buffer, juce::File& fileToSave, int sampleRate, int bitsPerSample=24)
+void ChorusFindAudioProcessor::callChorusDetectionAPI(int id, juce::uint64 fingerprint, int sampleRate, int format, CapturePool::Lease window)
 {
-    std::unique_ptr<juce::AudioFormatWriter> writer(juce::WavAudioFormat().createWriterFor(
-        new juce::FileOutputStream(fileToSave),
-        sampleRate,
-        buffer.getNumChannels(),
-        bitsPerSample,
-        {},
-        0
-    ));
+    //The server takes stereo: upload the first pair, which is L/R whenever the layout has one.
+    const auto& front = pairAnalyses.getFirst()->channels;
+    juce::AudioBuffer<float> pair;
+    window->getPair(front.left, front.right, pair);
 
-    if (writer != nullptr)
+    //Encode straight into memory on the worker, nothing touches the disk.
+    if (! uploadEncoder.encode(pair, pair.getNumSamples(), sampleRate, format, analysis::uploadMidOnly))
     {
-        writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+        logger->log(LogLevel::error, "Error encoding " + UploadEncoder::getWireName(format) + " data.");
+        abandonEvaluation(id);
+        return;
+    }
+
+    //The request keeps the window until it is answered, a 415 sends it again.
+    analysisClient.post(uploadEncoder.getBlock(), format, [this, id, fingerprint, format, window](const AnalysisClient::Result& result)
+        {
+            onApiResult(id, fingerprint, format, window, result);
+        });
+}
 
-        // Close the writer to finalize the file
-        delete writer.release();
+int ChorusFindAudioProcessor::getUploadFormat() const
+{
+    const int fallback = fallbackFormat.load();
+    return fallback >= 0 ? fallback : (int)paramReadUploadFormat->load();
+}
+
+bool ChorusFindAudioProcessor::useFallbackFormat(int rejected, const juce::StringArray& accepted)
+{
+    //Only the selected format falls back, so two formats can never take turns.
+    if (fallbackFormat.load() >= 0)
+        return false;
+
+    int fallback = UploadFormat::WAV_24;
+
+    for (const auto& name : accepted)
+    {
+        const int format = UploadEncoder::findFormat(name);
+
+        if (format >= 0)
+        {
+            fallback = format;
+            break;
+        }
     }
-    else
+
+    if (fallback == rejected)
+        return false;
+
+    fallbackFormat = fallback;
+    return true;
+}
+
+void ChorusFindAudioProcessor::onApiResult(int id, juce::uint64 fingerprint, int format, CapturePool::Lease window, const AnalysisClient::Result& result)
+{
+    //A newer request replaced this one and will finish the evaluation.
+    if (result.status == AnalysisClient::Result::Status::cancelled)
+        return;
+
+    //Unsupported Media Type: send the same window again in a format the server listed.
+    if (result.httpStatusCode == 415 && useFallbackFormat(format, result.acceptedFormats))
+    {
+        const int retryFormat = getUploadFormat();
+        const int sampleRate = (int)getAnalysisRate();
+
+        logger->log(LogLevel::warning, "Server does not accept " + UploadEncoder::getWireName(format)
+                                     + ", retrying as " + UploadEncoder::getWireName(retryFormat));
+
+        scheduleJob(analysisJob, JobScheduler::Priority::high, id, [this, id, fingerprint, sampleRate, retryFormat, window]()
+            {
+                callChorusDetectionAPI(id, fingerprint, sampleRate, retryFormat, window);
+            });
+        return;
+    }
+
+    if (! result.succeeded())
+    {
+        logger->log(LogLevel::error, "Analysis request failed: " + result.message);
+
+        //From the client's thread, so the alert is only posted, never waited for.
+        juce::MessageManager::callAsync([message = result.message]
+            {
+                juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon,
+                    "Error",
+                    "API is not accessible. Please make sure the analysis server is running.\n" + message);
+            });
+
+        abandonEvaluation(id);
+        return;
+    }
+
+    telemetry.addRoundTrip(result.roundTripMs);
+
+    if (fingerprint != 0)
+        resultCache->store(fingerprint, DetectionBackend::HTTP, result.value);
+
+    DBG("Analysis result " << result.value << " after " << result.roundTripMs << " ms");
+    finishEvaluation(id, result.value, fingerprint, DetectionBackend::HTTP);
+}
+
+void ChorusFindAudioProcessor::callAnalysisDaemon(int id, juce::uint64 fingerprint, const PlanarBuffer& window)
+{
+    //The same pair the server gets, but copied as float frames into the daemon's slot, so the window
+    //can go back to the pool as soon as post() returns.
+    const auto& front = pairAnalyses.getFirst()->channels;
+    juce::AudioBuffer<float> pair;
+    window.getPair(front.left, front.right, pair);
+
+    daemonClient.post(pair, (int)getAnalysisRate(), [this, id, fingerprint](const SharedMemoryClient::Result& result)
+        {
+            onDaemonResult(id, fingerprint, result);
+        });
+}
+
+void ChorusFindAudioProcessor::onDaemonResult(int id, juce::uint64 fingerprint, const SharedMemoryClient::Result& result)
+{
+    if (result.status == SharedMemoryClient::Result::Status::cancelled)
+        return;
+
+    if (! result.succeeded())
     {
-        juce::Logger::writeToLog("Error creating .wav writer.");
+        logger->log(LogLevel::error, "Daemon request failed: " + result.message);
+
+        //From the connection's thread, so the alert is only posted, never waited for.
+        juce::MessageManager::callAsync([message = result.message]
+            {
+                juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon,
+                    "Error",
+                    "Analysis daemon is not accessible. Please make sure it is running.\n" + message);
+            });
 
-        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon,
-            "Error",
-            "Error saving .wav file.");
+        abandonEvaluation(id);
+        return;
     }
+
+    telemetry.addRoundTrip(result.roundTripMs);
+
+    if (fingerprint != 0)
+        resultCache->store(fingerprint, DetectionBackend::DAEMON, result.value);
+
+    finishEvaluation(id, result.value, fingerprint, DetectionBackend::DAEMON);
+}
+
+void ChorusFindAudioProcessor::setApiUrl(const juce::String& url)
+{
+    parameters.state.setProperty(api::urlProperty, url, nullptr);
+    analysisClient.setEndpoint(url);
+
+    //A different server gets to decline the selected format again.
+    fallbackFormat = -1;
+}
+
+juce::String ChorusFindAudioProcessor::getApiUrl() const
+{
+    return analysisClient.getEndpoint();
 }
 
 //==============================================================================
@@ -316,15 +1010,57 @@ juce::AudioProcessorEditor* ChorusFindAudioProcessor::createEditor()
 //==============================================================================
 void ChorusFindAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    //Any thread the host likes, except the audio thread.
+    SessionState session;
+    session.parameters = parameters.copyState();
+    session.timeline = timeline.getData();
+
+    {
+        const juce::SpinLock::ScopedLockType sl(lastResultLock);
+        session.hasResult = lastResult.valid;
+        session.result = lastResult.value;
+        session.resultBackend = lastResult.backend;
+        session.resultFingerprint = lastResult.fingerprint;
+    }
+
+    session.writeTo(destData);
 }
 
 void ChorusFindAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    SessionState session;
+
+    if (! session.readFrom(data, sizeInBytes))
+    {
+        logger->log(LogLevel::warning, "Saved state not recognised, keeping the defaults.");
+        return;
+    }
+
+    if (session.parameters.hasType(parameters.state.getType()))
+    {
+        parameters.replaceState(session.parameters);
+        analysisClient.setEndpoint(parameters.state.getProperty(api::urlProperty, api::url).toString());
+        fallbackFormat = -1;
+    }
+
+    //The chorus amount came back with the parameters. Seeding the cache lets a re-evaluation
+    //of the same passage finish without touching the detector or the network.
+    if (session.hasResult)
+    {
+        if (session.resultFingerprint != 0)
+            resultCache->store(session.resultFingerprint, session.resultBackend, session.result);
+
+        const juce::SpinLock::ScopedLockType sl(lastResultLock);
+        lastResult = { true, session.result, session.resultBackend, session.resultFingerprint };
+    }
+
+    //Timeline mode plays the restored timeline back straight away.
+    if (! session.timeline.chorus.isEmpty() && session.timeline.hopSeconds > 0.0)
+    {
+        timeline.setData(session.timeline);
+    }
+
+    logger->log(LogLevel::info, "State restored, %g timeline hops.", (double)session.timeline.chorus.size());
 }
 
 //==============================================================================
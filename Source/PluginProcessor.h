@@ -11,11 +11,38 @@
 #include <JuceHeader.h>
 #include "Config.h"
 #include "State.h"
+#include "CaptureBuffer.h"
+#include "ChorusDetector.h"
+#include "StreamingAnalyser.h"
+#include "UploadEncoder.h"
+#include "ChunkedUploader.h"
+#include "AnalysisClient.h"
+#include "LockFreeQueue.h"
+#include "RealtimeChecks.h"
+#include "AsyncLogger.h"
+#include "ResultCache.h"
+#include "JobScheduler.h"
+#include "TransportTracker.h"
+#include "ChorusTimeline.h"
+#include "OfflineAnalyser.h"
+#include "Telemetry.h"
+#include "PolyphaseDecimator.h"
+#include "SessionState.h"
+#include "PeakFifo.h"
+#include "PlanarBuffer.h"
+#include "ChannelPairs.h"
+#include "StereoMeter.h"
+#include "ChorusModel.h"
+#include "ModelRunner.h"
+#include "SharedMemoryClient.h"
+#include "CapturePool.h"
 
 //==============================================================================
 /**
 */
-class ChorusFindAudioProcessor  : public juce::AudioProcessor
+class ChorusFindAudioProcessor  : public juce::AudioProcessor,
+                                  public juce::ChangeBroadcaster,
+                                  private juce::Timer
 {
 public:
     //==============================================================================
@@ -55,6 +82,65 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
+    //==============================================================================
+    //Analysis server address, used by the HTTP backend. Message thread only.
+    void setApiUrl(const juce::String& url);
+    juce::String getApiUrl() const;
+
+    //Asks the audio thread to start an evaluation. Message thread only.
+    void requestEvaluation();
+
+    //READY again once the window has been handed off to the workers, which can be before its
+    //result exists. Use getNumResultsApplied() to know when a result has arrived.
+    PluginState getEvaluationState() const { return currState.getPluginState(); }
+
+    //Evaluation results applied to the chorus amount so far. Any thread.
+    int getNumResultsApplied() const { return numResultsApplied.load(); }
+
+    //Evaluations that ended without a result, which left the chorus amount alone. Any thread.
+    int getNumEvaluationsAbandoned() const { return numEvaluationsAbandoned.load(); }
+
+    ResultCache::Stats getCacheStats() const;
+
+    //Whole-track timeline from the last offline render in Timeline mode.
+    int getTimelineNumHops() const;
+    int getTimelineNumPending() const;
+    bool exportTimeline(const juce::File& file) const;
+
+    //Result of each channel pair in the last native evaluation, e.g. "L/R 62%, Ls/Rs 40%". Message thread.
+    juce::String getPairSummary() const;
+
+    //A handed-off window is still being analysed, the next one may already be captured. Any thread.
+    bool isAnalysing() const { return analysingEvaluationId.load() != 0; }
+
+    //Performance counters of this instance, with the queue and buffer levels sampled now.
+    Telemetry::Snapshot getTelemetry() const;
+    void resetTelemetry();
+
+    //Input peaks for the editor's waveform and meter. The editor is the only reader.
+    PeakFifo& getPeakFifo() { return peaks; }
+
+    //Running stereo-image features of the first channel pair, updated by every processBlock. Any thread.
+    const StereoMeter& getStereoMeter() const { return stereoMeter; }
+
+    //Change messages go out on the message thread when the evaluation state, the timeline or the
+    //cache counters change, and only while an editor is open.
+    struct StatusStamp
+    {
+        PluginState state = PluginState::READY;
+        int timelineHops = 0;
+        int timelinePending = 0;
+        juce::int64 cacheHits = 0;
+        juce::int64 cacheMisses = 0;
+        bool analysing = false;
+
+        bool operator!=(const StatusStamp& other) const
+        {
+            return state != other.state || timelineHops != other.timelineHops || timelinePending != other.timelinePending
+                || cacheHits != other.cacheHits || cacheMisses != other.cacheMisses || analysing != other.analysing;
+        }
+    };
+
 private:
     //Value Tree State.
     juce::AudioProcessorValueTreeState parameters;
@@ -62,14 +148,240 @@ private:
     //Chorus Calculation State
     State currState;
 
-    //Listening Buffer
-    juce::AudioBuffer<float> bufListen{2, 48000 * 2};
-    int listenWriteIndex = 0;
+    //Process-wide logger, safe to use from the audio thread.
+    juce::SharedResourcePointer<AsyncLogger> logger;
+    using LogLevel = AsyncLogger::Level;
+
+    //processBlock load, analysis and network timings.
+    Telemetry telemetry;
+
+    //Snapshots are appended here every metrics::fileIntervalMs when set.
+    juce::File metricsFile;
+    juce::uint32 lastMetricsMs = 0;
+    void writeMetrics();
+
+    //Always-on capture ring, written by every processBlock call. It holds the input decimated
+    //to about analysis::targetRate, everything that reads it works at getAnalysisRate().
+    //One channel per input channel, at least two.
+    CaptureRingBuffer ringCapture;
+    int numCaptureChannels = 2;
+
+    //Anti-aliasing and decimation in front of the ring, and its output for one slice of a block.
+    PolyphaseDecimator decimator;
+    juce::AudioBuffer<float> bufDecimated;
+    int decimatorSliceSize = 0;
+
+    void pushToCapture(const juce::AudioBuffer<float>& buffer, int numInputChannels);
+    double getAnalysisRate() const noexcept { return decimator.getOutputRate(); }
+
+    //Input samples since prepareToPlay. The transport works on these, ring position = input position / decimator factor.
+    juce::int64 inputPosition = 0;
+
+    //Min/max peaks of the input, audio thread -> editor.
+    PeakFifo peaks;
+
+    //Fed with the decimated first pair (frontLeft, frontRight) in pushToCapture.
+    StereoMeter stereoMeter;
+    int frontLeft = 0;
+    int frontRight = 1;
+
+    //Evaluated windows, every capture channel, are checked out of the process-wide pool when an
+    //evaluation starts and go back once analysed. Idle instances hold none.
+    juce::SharedResourcePointer<CapturePool> capturePool;
+
+    //Host bar grid, used to place bar-aligned windows. Audio thread only.
+    TransportTracker transport;
+
+    //Timeline mode: built during offline renders, played back as automation otherwise.
+    ChorusTimeline timeline;
+    OfflineAnalyser offlineAnalyser{ ringCapture, timeline };
+    juce::int64 offlineExpectedHostSample = -1;
+    float lastTimelineValue = -1.0f;
+
+    void processOfflineBlock(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, juce::int64 blockStart, int numSamples);
+    void followTimeline(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position);
+
+    //Ring position one past the last sample of the window being evaluated.
+    std::atomic<juce::int64> captureEndPosition{ 0 };
+    std::atomic<int> captureWindowSamples{ 0 };
+
+    //Length of the fixed window that the ring can still hold.
+    int getCaptureWindowLength() const;
+
+    //Copies the window into a buffer checked out of the pool. False if it was overwritten first.
+    bool snapshotCaptureWindow(PlanarBuffer& window);
+
+    //Message thread: the evaluation waiting for a pool buffer, and until when it may wait.
+    int checkoutEvaluationId = 0;
+    juce::uint32 checkoutDeadline = 0;
+
+    //Message thread: a finished capture already copied out of the ring, waiting for the previous analysis.
+    CapturePool::Lease capturedWindow;
+    int capturedEvaluationId = 0;
+
+    //Checks a buffer out and copies the window into it, or abandons the evaluation if either fails.
+    void captureWindow(int id);
+
+    //Id of the evaluation whose window the workers are analysing, 0 for none. Windows are analysed
+    //one at a time per instance (the pair detectors and clients are per instance), but the next
+    //capture starts as soon as the window has been handed off.
+    std::atomic<int> analysingEvaluationId{ 0 };
+
+    //NATIVE and MODEL backends: one detector and one model runner per channel pair of the input bus,
+    //the pairs of a window are analysed in parallel on the worker threads. Rebuilt in prepareToPlay.
+    struct PairAnalysis
+    {
+        ChannelPair channels;
+        ChorusDetector detector;
+        ModelRunner model;
+
+        //-1 until analysed. weight is the pair's RMS level in the window.
+        std::atomic<float> result{ -1.0f };
+        float weight = 0.0f;
+    };
+
+    juce::OwnedArray<PairAnalysis> pairAnalyses;
+    std::atomic<int> pairsRemaining{ 0 };
+
+    //Detector version, model file, server or daemon of a backend, hashed into the cache fingerprint.
+    juce::uint64 getAnalyserIdentity(int backend) const;
+
+    void analysePairs(int id, juce::uint64 fingerprint, int backend, const CapturePool::Lease& window);
+    void analysePair(int index, int id, juce::uint64 fingerprint, int backend, double startMs, const PlanarBuffer& window);
+
+    //fingerprint and backend identify what the result was computed from, 0 if it should not be remembered.
+    void finishEvaluation(int id, float result, juce::uint64 fingerprint = 0, int backend = 0);
 
-    static juce::ThreadPool sharedThredPool;
+    //Ends an evaluation that has no result (cancelled, no worker, no window, failed request). The state
+    //moves on, the chorus amount and the saved result are left as they are.
+    void abandonEvaluation(int id);
 
-    float callChorusDetectionAPI(int sampleRate, int bitsPerSample = 24);
-    void saveAudioBufferAsWav(const juce::AudioBuffer<float>& buffer, juce::File& fileToSave, int sampleRate, int bitsPerSample);
+    //Last applied evaluation, saved with the project. Written on the message thread, read by getStateInformation.
+    struct LastResult
+    {
+        bool valid = false;
+        float value = 0.0f;
+        int backend = 0;
+        juce::uint64 fingerprint = 0;
+    };
+
+    juce::SpinLock lastResultLock;
+    LastResult lastResult;
+
+    //==============================================================================
+    //Editor -> audio thread.
+    enum class Command
+    {
+        evaluate
+    };
+
+    SpscQueue<Command, 16> commands;
+
+    //Workers -> message thread.
+    struct EvaluationResult
+    {
+        enum class Kind
+        {
+            evaluation,
+            live,
+            abandoned
+        };
+
+        Kind kind = Kind::evaluation;
+        int evaluationId = 0;
+        float value = 0.0f;
+        juce::uint64 fingerprint = 0;
+        int backend = 0;
+    };
+
+    MpscQueue<EvaluationResult, 64> results;
+
+    //Bumped by the audio thread when an evaluation starts.
+    std::atomic<int> evaluationId{ 0 };
+
+    //Message thread only.
+    int launchedEvaluationId = 0;
+    int appliedEvaluationId = 0;
+    std::atomic<int> numResultsApplied{ 0 };
+    std::atomic<int> numEvaluationsAbandoned{ 0 };
+    int abandonedEvaluationId = 0;
+    bool hasPendingResult = false;
+    EvaluationResult pendingResult;
+
+    //Launches the worker jobs and applies results, owns the CALCULATING -> BACKGROUND -> READY transitions.
+    void timerCallback() override;
+    //Hands a window copied by captureWindow() to the workers.
+    void launchAnalysis(int id, CapturePool::Lease window);
+    void applyResults();
+
+    //Message thread. Sends a change message when the status differs from the last one sent.
+    StatusStamp lastStatus;
+    void notifyStatusChanges();
+
+    //Worker behind the continuous mode. Declared after the ring it follows.
+    StreamingAnalyser streamingAnalyser{ ringCapture, stereoMeter };
+
+    //This instance's jobs on the worker threads shared by all instances.
+    JobScheduler::Client jobs;
+
+    enum JobKey
+    {
+        analysisJob,
+        streamingUploadJob,
+        metricsJob,
+
+        //pairJob + i analyses channel pair i, keep it last.
+        pairJob
+    };
+
+    //False if the job was refused, the evaluation is abandoned then.
+    bool scheduleJob(JobKey key, JobScheduler::Priority priority, int id, std::function<void()> job);
+
+    //Stops every job and request of this instance and ends the evaluation they were working on.
+    //New jobs are refused until jobs.resume().
+    void cancelEvaluationJobs();
+
+    //A fingerprint of 0 means the result is not cached.
+    void callChorusDetectionAPI(int id, juce::uint64 fingerprint, int sampleRate, int format, CapturePool::Lease window);
+    void onApiResult(int id, juce::uint64 fingerprint, int format, CapturePool::Lease window, const AnalysisClient::Result& result);
+
+    //The selected UploadFormat, unless the server turned it down.
+    int getUploadFormat() const;
+
+    //After the server rejected format: switches to one it listed (or WAV 24-bit, which every
+    //server reads) until the URL changes. False if there is nothing else left to try.
+    bool useFallbackFormat(int rejected, const juce::StringArray& accepted);
+    std::atomic<int> fallbackFormat{ -1 };
+
+    //Results of earlier evaluations, shared by all instances.
+    juce::SharedResourcePointer<ResultCache> resultCache;
+
+    //In-process classifier for the MODEL backend, shared by all instances. Without a model file
+    //the MODEL backend falls back to NATIVE.
+    juce::SharedResourcePointer<ChorusModel> chorusModel;
+
+    //Reused upload body for the HTTP backend.
+    UploadEncoder uploadEncoder;
+
+    //Long-lived client for the analysis server.
+    AnalysisClient analysisClient;
+
+    //DAEMON backend: the first pair handed to a local analysis daemon through shared memory.
+    void callAnalysisDaemon(int id, juce::uint64 fingerprint, const PlanarBuffer& window);
+    void onDaemonResult(int id, juce::uint64 fingerprint, const SharedMemoryClient::Result& result);
+    SharedMemoryClient daemonClient;
+
+    //Streamed upload of the window while it is still being captured.
+    ChunkedUploader chunkedUploader;
+    void runStreamingUpload(int id);
+
+    //Written by the audio thread before it publishes LISTENING.
+    std::atomic<bool> streamingUploadActive{ false };
+
+   #if CHORUSFIND_RT_CHECKS
+    //Prints what the real-time checks trap in processBlock.
+    juce::SharedResourcePointer<rtcheck::Reporter> rtReporter;
+   #endif
 
     //Adding parameters to parameter layout.
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout()
@@ -85,12 +397,31 @@ private:
         //Lambda function to add juce::AudioParameterInt
         const auto addIntParameter = [&](parameters::audioParameterInt paramInt)
         {
-            params.add(std::make_unique<juce::AudioParameterFloat>(paramInt.id, paramInt.name, paramInt.minValue, paramInt.maxValue, paramInt.defaultValue));
+            params.add(std::make_unique<juce::AudioParameterInt>(paramInt.id, paramInt.name, paramInt.minValue, paramInt.maxValue, paramInt.defaultValue));
+        };
+
+        //Lambda function to add juce::AudioParameterChoice
+        const auto addChoiceParameter = [&](parameters::audioParameterChoice paramChoice)
+        {
+            params.add(std::make_unique<juce::AudioParameterChoice>(paramChoice.id, paramChoice.name, paramChoice.choices, paramChoice.defaultIndex));
+        };
+
+        //Lambda function to add juce::AudioParameterBool
+        const auto addBoolParameter = [&](parameters::audioParameterBool paramBool)
+        {
+            params.add(std::make_unique<juce::AudioParameterBool>(paramBool.id, paramBool.name, paramBool.defaultValue));
         };
 
         //Adding parameters using above lambda functions.
         addFloatParameter(parameters::chorusAmount);
         addIntParameter(parameters::chorusState);
+        addFloatParameter(parameters::captureSeconds);
+        addChoiceParameter(parameters::backend);
+        addChoiceParameter(parameters::mode);
+        addBoolParameter(parameters::streamUpload);
+        addBoolParameter(parameters::barAligned);
+        addIntParameter(parameters::windowBars);
+        addChoiceParameter(parameters::uploadFormat);
 
         return params;
     };
@@ -99,6 +430,13 @@ private:
 
     //Reading parameter values.
     std::atomic<float>* paramReadChorusAmount = nullptr;    
+    std::atomic<float>* paramReadCaptureSeconds = nullptr;
+    std::atomic<float>* paramReadBackend = nullptr;
+    std::atomic<float>* paramReadMode = nullptr;
+    std::atomic<float>* paramReadStreamUpload = nullptr;
+    std::atomic<float>* paramReadBarAligned = nullptr;
+    std::atomic<float>* paramReadWindowBars = nullptr;
+    std::atomic<float>* paramReadUploadFormat = nullptr;
 
     //Modifying parameter values.
     juce::RangedAudioParameter* paramChorusAmount = nullptr;
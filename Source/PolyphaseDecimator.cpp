@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    PolyphaseDecimator.cpp
+    Created: 19 Oct 2026 2:36:50pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "PolyphaseDecimator.h"
+#include "AnalysisKernels.h"
+#include "Config.h"
+
+void PolyphaseDecimator::prepare(double inputRate, double targetRate, int numChannels)
+{
+    factor = juce::jmax(1, juce::roundToInt(inputRate / targetRate));
+    outputRate = inputRate / factor;
+
+    numTaps = factor > 1 ? factor * analysis::tapsPerPhase : 0;
+    latency = numTaps > 0 ? juce::roundToInt((numTaps - 1) * 0.5 / factor) : 0;
+
+    coefficients.allocate((size_t)juce::jmax(1, numTaps), true);
+    history.setSize(numChannels, juce::jmax(1, 2 * numTaps));
+
+    //Windowed sinc with its -6 dB point at analysis::cutoff of the output rate. The
+    //filter is symmetric, so the coefficients need no reversing for the dot product.
+    const double cutoff = analysis::cutoff / factor;
+    const double centre = (numTaps - 1) * 0.5;
+    double sum = 0.0;
+
+    for (int i = 0; i < numTaps; ++i)
+    {
+        const double x = i - centre;
+        const double sinc = x == 0.0 ? 2.0 * cutoff : std::sin(juce::MathConstants<double>::twoPi * cutoff * x) / (juce::MathConstants<double>::pi * x);
+
+        //Blackman window
+        const double w = juce::MathConstants<double>::twoPi * i / (numTaps - 1);
+        const double window = 0.42 - 0.5 * std::cos(w) + 0.08 * std::cos(2.0 * w);
+
+        coefficients[i] = (float)(sinc * window);
+        sum += sinc * window;
+    }
+
+    //Unity gain at DC.
+    for (int i = 0; i < numTaps; ++i)
+        coefficients[i] = (float)(coefficients[i] / sum);
+
+    //Resolves the kernel set here rather than on the first audio block.
+    kernels::get();
+
+    reset();
+}
+
+void PolyphaseDecimator::reset()
+{
+    history.clear();
+    writeIndex = 0;
+    phase = 0;
+}
+
+int PolyphaseDecimator::process(const juce::AudioBuffer<float>& source, int startSample, int numSamples, int numSourceChannels,
+                                juce::AudioBuffer<float>& dest) noexcept
+{
+    jassert(dest.getNumSamples() >= getMaxOutputSamples(numSamples));
+
+    int numWritten = 0;
+    int channelPhase = phase;
+    int channelWriteIndex = writeIndex;
+
+    for (int channel = 0; channel < dest.getNumChannels(); ++channel)
+    {
+        const float* src = numSourceChannels > 0 ? source.getReadPointer(juce::jmin(channel, numSourceChannels - 1), startSample) : nullptr;
+        auto* out = dest.getWritePointer(channel);
+
+        //Nothing to filter at the input rate.
+        if (factor == 1)
+        {
+            if (src != nullptr)
+                juce::FloatVectorOperations::copy(out, src, numSamples);
+            else
+                juce::FloatVectorOperations::clear(out, numSamples);
+
+            numWritten = numSamples;
+            continue;
+        }
+
+        auto* taps = history.getWritePointer(juce::jmin(channel, history.getNumChannels() - 1));
+        channelPhase = phase;
+        channelWriteIndex = writeIndex;
+        numWritten = 0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float sample = src != nullptr ? src[i] : 0.0f;
+            taps[channelWriteIndex] = sample;
+            taps[channelWriteIndex + numTaps] = sample;
+
+            if (++channelWriteIndex == numTaps)
+                channelWriteIndex = 0;
+
+            //taps + channelWriteIndex is the oldest sample of a contiguous run of numTaps.
+            if (++channelPhase == factor)
+            {
+                channelPhase = 0;
+                out[numWritten++] = kernels::dotProduct(coefficients.get(), taps + channelWriteIndex, numTaps);
+            }
+        }
+    }
+
+    phase = channelPhase;
+    writeIndex = channelWriteIndex;
+    return numWritten;
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    PolyphaseDecimator.h
+    Created: 19 Oct 2026 2:36:50pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Anti-aliased integer-factor decimator.
+
+    A windowed-sinc low-pass of factor * analysis::tapsPerPhase taps is only
+    evaluated for the samples that are kept, which is the same work as running
+    its factor polyphase branches at the output rate: analysis::tapsPerPhase
+    multiply-adds per output sample and channel. The history is stored twice
+    in a row so every output is one contiguous dot product.
+
+    State carries over between calls, so blocks of any length can be pushed as
+    they arrive. An input position p maps to output position p / getFactor().
+
+    All memory is allocated in prepare(); process() never allocates or locks.
+*/
+class PolyphaseDecimator
+{
+public:
+    PolyphaseDecimator() = default;
+
+    //Picks the factor closest to inputRate / targetRate and designs the filter.
+    void prepare(double inputRate, double targetRate, int numChannels);
+    void reset();
+
+    int getFactor() const noexcept { return factor; }
+    double getOutputRate() const noexcept { return outputRate; }
+
+    //Group delay of the filter, in output samples.
+    int getLatency() const noexcept { return latency; }
+
+    //Most output samples one call with numInputSamples can produce.
+    int getMaxOutputSamples(int numInputSamples) const noexcept { return numInputSamples / factor + 1; }
+
+    //Decimates numSamples of source from startSample into dest, starting at dest sample 0.
+    //Channels beyond numSourceChannels repeat the last one, no source channels give silence.
+    //dest needs getMaxOutputSamples(numSamples) samples. Returns the number written.
+    int process(const juce::AudioBuffer<float>& source, int startSample, int numSamples, int numSourceChannels,
+                juce::AudioBuffer<float>& dest) noexcept;
+
+private:
+    int factor = 1;
+    double outputRate = 0.0;
+    int latency = 0;
+
+    int numTaps = 0;
+    juce::HeapBlock<float> coefficients;
+
+    //Per channel: numTaps samples, stored twice.
+    juce::AudioBuffer<float> history;
+    int writeIndex = 0;
+    int phase = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PolyphaseDecimator)
+};
@@ -0,0 +1,429 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.cpp
+    Created: 18 Oct 2026 11:05:18am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "RealtimeChecks.h"
+
+const char* rtcheck::getKindName(Kind kind) noexcept
+{
+    switch (kind)
+    {
+    case Kind::allocation:      return "allocation";
+    case Kind::deallocation:    return "deallocation";
+    case Kind::lock:            return "lock";
+    case Kind::fileAccess:      return "file access";
+    case Kind::sleep:           return "sleep";
+    case Kind::explicitCheck:   return "unsafe call";
+    default:                    return "unknown";
+    }
+}
+
+#if CHORUSFIND_RT_CHECKS
+
+#include "LockFreeQueue.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if JUCE_WINDOWS
+ #include <windows.h>
+ #include <dbghelp.h>
+ #include <crtdbg.h>
+ #pragma comment(lib, "DbgHelp.lib")
+#else
+ #include <execinfo.h>
+ #include <dlfcn.h>
+ #include <fcntl.h>
+ #include <cstdarg>
+ #include <pthread.h>
+ #include <time.h>
+#endif
+
+namespace
+{
+    static constexpr int maxFrames = 24;
+
+    struct Record
+    {
+        rtcheck::Kind kind = rtcheck::Kind::explicitCheck;
+        const char* detail = nullptr;
+        juce::int64 block = 0;
+
+        //A summary closes a block, count is the number of violations in it.
+        bool isSummary = false;
+        int count = 0;
+
+        int numFrames = 0;
+        void* frames[maxFrames] = {};
+    };
+
+    //Filled in place, nothing here allocates.
+    MpscQueue<Record, 256> records;
+    std::atomic<juce::int64> totalViolations{ 0 };
+    std::atomic<juce::int64> droppedRecords{ 0 };
+
+    struct ThreadState
+    {
+        int scopeDepth = 0;
+        int suppressed = 0;
+        juce::int64 block = 0;
+        int blockViolations = 0;
+    };
+
+    //Trivially destructible, so it is safe to touch from operator delete during thread exit.
+    thread_local ThreadState threadState;
+
+    //Calls made by the checks themselves are not violations.
+    struct Suppress
+    {
+        Suppress() noexcept     { ++threadState.suppressed; }
+        ~Suppress() noexcept    { --threadState.suppressed; }
+    };
+
+    int captureFrames(void** frames) noexcept
+    {
+       #if JUCE_WINDOWS
+        return (int)RtlCaptureStackBackTrace(2, maxFrames, frames, nullptr);
+       #else
+        return backtrace(frames, maxFrames);
+       #endif
+    }
+
+    void push(const Record& record) noexcept
+    {
+        if (! records.push(record))
+            ++droppedRecords;
+    }
+}
+
+//==============================================================================
+void rtcheck::noteViolation(Kind kind, const char* detail) noexcept
+{
+    auto& state = threadState;
+
+    if (state.scopeDepth == 0 || state.suppressed > 0)
+        return;
+
+    const Suppress suppress;
+
+    Record record;
+    record.kind = kind;
+    record.detail = detail;
+    record.block = state.block;
+    record.numFrames = captureFrames(record.frames);
+
+    ++state.blockViolations;
+    ++totalViolations;
+    push(record);
+}
+
+bool rtcheck::isInRealtimeScope() noexcept
+{
+    return threadState.scopeDepth > 0;
+}
+
+juce::int64 rtcheck::getTotalViolations() noexcept
+{
+    return totalViolations.load();
+}
+
+rtcheck::RealtimeScope::RealtimeScope() noexcept
+{
+    auto& state = threadState;
+
+    if (state.scopeDepth++ == 0)
+    {
+        ++state.block;
+        state.blockViolations = 0;
+    }
+}
+
+rtcheck::RealtimeScope::~RealtimeScope() noexcept
+{
+    auto& state = threadState;
+
+    if (--state.scopeDepth == 0 && state.blockViolations > 0)
+    {
+        Record summary;
+        summary.isSummary = true;
+        summary.block = state.block;
+        summary.count = state.blockViolations;
+        push(summary);
+    }
+}
+
+//==============================================================================
+rtcheck::Reporter::Reporter()
+    : juce::Thread("ChorusFind RT check reporter")
+{
+   #if JUCE_WINDOWS
+    SymInitialize(GetCurrentProcess(), nullptr, TRUE);
+   #endif
+
+    startThread(juce::Thread::Priority::low);
+}
+
+rtcheck::Reporter::~Reporter()
+{
+    stopThread(2000);
+    drain();
+
+   #if JUCE_WINDOWS
+    SymCleanup(GetCurrentProcess());
+   #endif
+}
+
+void rtcheck::Reporter::run()
+{
+    while (! threadShouldExit())
+    {
+        drain();
+        wait(100);
+    }
+}
+
+void rtcheck::Reporter::drain()
+{
+    Record record;
+
+    while (records.pop(record))
+    {
+        if (record.isSummary)
+        {
+            std::fprintf(stderr, "[rtcheck] processBlock #%lld: %d violation%s\n",
+                         (long long)record.block, record.count, record.count == 1 ? "" : "s");
+            continue;
+        }
+
+        std::fprintf(stderr, "[rtcheck] processBlock #%lld: %s%s%s\n", (long long)record.block, getKindName(record.kind),
+                     record.detail != nullptr ? " - " : "", record.detail != nullptr ? record.detail : "");
+
+       #if JUCE_WINDOWS
+        alignas(SYMBOL_INFO) char symbolStorage[sizeof(SYMBOL_INFO) + 256] = {};
+        auto* symbol = reinterpret_cast<SYMBOL_INFO*>(symbolStorage);
+        symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+        symbol->MaxNameLen = 255;
+
+        for (int i = 0; i < record.numFrames; ++i)
+        {
+            DWORD64 displacement = 0;
+
+            if (SymFromAddr(GetCurrentProcess(), (DWORD64)record.frames[i], &displacement, symbol))
+                std::fprintf(stderr, "    %2d: %s + %llu\n", i, symbol->Name, (unsigned long long)displacement);
+            else
+                std::fprintf(stderr, "    %2d: %p\n", i, record.frames[i]);
+        }
+       #else
+        //Skip captureFrames and noteViolation.
+        const int firstFrame = juce::jmin(2, record.numFrames);
+
+        if (auto* symbols = backtrace_symbols(record.frames + firstFrame, record.numFrames - firstFrame))
+        {
+            for (int i = 0; i < record.numFrames - firstFrame; ++i)
+                std::fprintf(stderr, "    %2d: %s\n", i, symbols[i]);
+
+            std::free(symbols);
+        }
+       #endif
+    }
+
+    if (const auto dropped = droppedRecords.exchange(0))
+        std::fprintf(stderr, "[rtcheck] %lld violation records dropped, the queue was full\n", (long long)dropped);
+}
+
+//==============================================================================
+//Allocation hooks. operator new / delete are replaced on every platform.
+namespace
+{
+    void* allocate(std::size_t size) noexcept
+    {
+        rtcheck::noteViolation(rtcheck::Kind::allocation);
+
+        const Suppress suppress;
+        return std::malloc(size != 0 ? size : 1);
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        rtcheck::noteViolation(rtcheck::Kind::allocation);
+
+        const Suppress suppress;
+        const auto align = juce::jmax((std::size_t)alignment, sizeof(void*));
+       #if JUCE_WINDOWS
+        return _aligned_malloc(size != 0 ? size : 1, align);
+       #else
+        void* result = nullptr;
+        return posix_memalign(&result, align, size != 0 ? size : 1) == 0 ? result : nullptr;
+       #endif
+    }
+
+    void release(void* pointer) noexcept
+    {
+        if (pointer == nullptr)
+            return;
+
+        rtcheck::noteViolation(rtcheck::Kind::deallocation);
+
+        const Suppress suppress;
+        std::free(pointer);
+    }
+
+    void releaseAligned(void* pointer) noexcept
+    {
+        if (pointer == nullptr)
+            return;
+
+        rtcheck::noteViolation(rtcheck::Kind::deallocation);
+
+        const Suppress suppress;
+       #if JUCE_WINDOWS
+        _aligned_free(pointer);
+       #else
+        std::free(pointer);
+       #endif
+    }
+
+    void* allocateOrThrow(std::size_t size)
+    {
+        if (auto* result = allocate(size))
+            return result;
+
+        throw std::bad_alloc();
+    }
+
+    void* allocateAlignedOrThrow(std::size_t size, std::align_val_t alignment)
+    {
+        if (auto* result = allocateAligned(size, alignment))
+            return result;
+
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new  (std::size_t size)                                      { return allocateOrThrow(size); }
+void* operator new[](std::size_t size)                                      { return allocateOrThrow(size); }
+void* operator new  (std::size_t size, const std::nothrow_t&) noexcept      { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept      { return allocate(size); }
+void* operator new  (std::size_t size, std::align_val_t alignment)          { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment)          { return allocateAlignedOrThrow(size, alignment); }
+void* operator new  (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept  { return allocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept  { return allocateAligned(size, alignment); }
+
+void operator delete  (void* pointer) noexcept                              { release(pointer); }
+void operator delete[](void* pointer) noexcept                              { release(pointer); }
+void operator delete  (void* pointer, std::size_t) noexcept                 { release(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept                 { release(pointer); }
+void operator delete  (void* pointer, const std::nothrow_t&) noexcept       { release(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept       { release(pointer); }
+void operator delete  (void* pointer, std::align_val_t) noexcept            { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept            { releaseAligned(pointer); }
+void operator delete  (void* pointer, std::size_t, std::align_val_t) noexcept   { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept   { releaseAligned(pointer); }
+
+#if JUCE_WINDOWS && defined(_DEBUG)
+//The debug CRT reports malloc / realloc / free through an allocation hook.
+namespace
+{
+    int crtAllocationHook(int allocType, void*, size_t, int blockType, long, const unsigned char*, int)
+    {
+        if (blockType != _CRT_BLOCK)
+            rtcheck::noteViolation(allocType == _HOOK_FREE ? rtcheck::Kind::deallocation : rtcheck::Kind::allocation, "CRT heap");
+
+        return TRUE;
+    }
+
+    const auto previousCrtHook = _CrtSetAllocHook(crtAllocationHook);
+}
+#endif
+
+//==============================================================================
+#if JUCE_LINUX || JUCE_MAC
+//Symbol interposition. These only take effect for calls that bind to this binary.
+namespace
+{
+    template <typename FunctionType>
+    FunctionType resolveNext(const char* name) noexcept
+    {
+        return reinterpret_cast<FunctionType>(dlsym(RTLD_NEXT, name));
+    }
+
+    using MutexLockFunction = int (*)(pthread_mutex_t*);
+    using OpenFunction      = int (*)(const char*, int, ...);
+    using FopenFunction     = FILE* (*)(const char*, const char*);
+    using ReadFunction      = ssize_t (*)(int, void*, size_t);
+    using WriteFunction     = ssize_t (*)(int, const void*, size_t);
+    using NanosleepFunction = int (*)(const struct timespec*, struct timespec*);
+
+    //Resolved before main, so the hooks never call dlsym from inside a real-time scope.
+    const auto nextMutexLock = resolveNext<MutexLockFunction>("pthread_mutex_lock");
+    const auto nextOpen      = resolveNext<OpenFunction>("open");
+    const auto nextFopen     = resolveNext<FopenFunction>("fopen");
+    const auto nextRead      = resolveNext<ReadFunction>("read");
+    const auto nextWrite     = resolveNext<WriteFunction>("write");
+    const auto nextNanosleep = resolveNext<NanosleepFunction>("nanosleep");
+}
+
+extern "C"
+{
+    int pthread_mutex_lock(pthread_mutex_t* mutex)
+    {
+        rtcheck::noteViolation(rtcheck::Kind::lock, "pthread_mutex_lock");
+        return (nextMutexLock != nullptr ? nextMutexLock : resolveNext<MutexLockFunction>("pthread_mutex_lock"))(mutex);
+    }
+
+    int open(const char* path, int flags, ...)
+    {
+        rtcheck::noteViolation(rtcheck::Kind::fileAccess, "open");
+
+        int mode = 0;
+
+        //The mode argument is only passed when a file can be created. O_TMPFILE is Linux only.
+        bool hasMode = (flags & O_CREAT) != 0;
+       #ifdef O_TMPFILE
+        hasMode = hasMode || (flags & O_TMPFILE) == O_TMPFILE;
+       #endif
+
+        if (hasMode)
+        {
+            va_list args;
+            va_start(args, flags);
+            mode = va_arg(args, int);
+            va_end(args);
+        }
+
+        return (nextOpen != nullptr ? nextOpen : resolveNext<OpenFunction>("open"))(path, flags, mode);
+    }
+
+    FILE* fopen(const char* path, const char* mode)
+    {
+        rtcheck::noteViolation(rtcheck::Kind::fileAccess, "fopen");
+        return (nextFopen != nullptr ? nextFopen : resolveNext<FopenFunction>("fopen"))(path, mode);
+    }
+
+    ssize_t read(int fd, void* data, size_t size)
+    {
+        rtcheck::noteViolation(rtcheck::Kind::fileAccess, "read");
+        return (nextRead != nullptr ? nextRead : resolveNext<ReadFunction>("read"))(fd, data, size);
+    }
+
+    ssize_t write(int fd, const void* data, size_t size)
+    {
+        rtcheck::noteViolation(rtcheck::Kind::fileAccess, "write");
+        return (nextWrite != nullptr ? nextWrite : resolveNext<WriteFunction>("write"))(fd, data, size);
+    }
+
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        rtcheck::noteViolation(rtcheck::Kind::sleep, "nanosleep");
+        return (nextNanosleep != nullptr ? nextNanosleep : resolveNext<NanosleepFunction>("nanosleep"))(duration, remaining);
+    }
+}
+#endif
+
+#endif
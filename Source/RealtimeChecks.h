@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    RealtimeChecks.h
+    Created: 18 Oct 2026 11:05:18am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//Instrumentation build mode, on in the Debug configuration. Set CHORUSFIND_RT_CHECKS=1
+//in any other build (CI, benchmark harness) to turn it on there too.
+#ifndef CHORUSFIND_RT_CHECKS
+ #define CHORUSFIND_RT_CHECKS 0
+#endif
+
+//==============================================================================
+/**
+    Traps real-time unsafe calls made while processBlock runs.
+
+    The audio thread marks processBlock with a RealtimeScope. While it is open:
+     - operator new / delete are trapped on every platform, CRT malloc / free
+       too in MSVC debug builds,
+     - pthread_mutex_lock, open, fopen, read, write and nanosleep are trapped
+       on Linux and macOS when they resolve to this binary (the standalone app
+       and the benchmark harness, not a plugin loaded by a host),
+     - code that knows it is unsafe can say so with CHORUSFIND_RT_UNSAFE.
+
+    A violation only captures raw stack frames and pushes them to a lock-free
+    queue. The Reporter thread symbolises and prints them, followed by a
+    summary with the number of violations in that block.
+*/
+namespace rtcheck
+{
+    enum class Kind
+    {
+        allocation,
+        deallocation,
+        lock,
+        fileAccess,
+        sleep,
+        explicitCheck
+    };
+
+    const char* getKindName(Kind kind) noexcept;
+
+#if CHORUSFIND_RT_CHECKS
+    //Records a violation if the calling thread is inside a RealtimeScope.
+    void noteViolation(Kind kind, const char* detail = nullptr) noexcept;
+
+    bool isInRealtimeScope() noexcept;
+
+    //Violations recorded since startup, all threads.
+    juce::int64 getTotalViolations() noexcept;
+
+    //Marks the calling thread as real-time for its lifetime. Nestable.
+    class RealtimeScope
+    {
+    public:
+        RealtimeScope() noexcept;
+        ~RealtimeScope() noexcept;
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE(RealtimeScope)
+    };
+
+    //Prints queued violations. Hold one through a SharedResourcePointer.
+    class Reporter : private juce::Thread
+    {
+    public:
+        Reporter();
+        ~Reporter() override;
+
+    private:
+        void run() override;
+        void drain();
+
+        JUCE_DECLARE_NON_COPYABLE(Reporter)
+    };
+#endif
+}
+
+#if CHORUSFIND_RT_CHECKS
+ #define CHORUSFIND_REALTIME_SCOPE  const rtcheck::RealtimeScope JUCE_JOIN_MACRO(realtimeScope_, __LINE__);
+ #define CHORUSFIND_RT_UNSAFE(what)  rtcheck::noteViolation(rtcheck::Kind::explicitCheck, what);
+#else
+ #define CHORUSFIND_REALTIME_SCOPE
+ #define CHORUSFIND_RT_UNSAFE(what)
+#endif
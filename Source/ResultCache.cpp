@@ -0,0 +1,234 @@
+/*
+  ==============================================================================
+
+    ResultCache.cpp
+    Created: 18 Oct 2026 3:02:33pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "ResultCache.h"
+#include "Config.h"
+#include "AnalysisKernels.h"
+
+namespace
+{
+    //File header, bumped when the layout changes.
+    static constexpr int fileMagic = 0x43524643; // "CFRC"
+    static constexpr int fileVersion = 2;
+
+    //FNV-1a, 64 bit.
+    struct Hasher
+    {
+        juce::uint64 value = 14695981039346656037ull;
+
+        void add(juce::uint64 data) noexcept
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                value ^= (data >> (i * 8)) & 0xff;
+                value *= 1099511628211ull;
+            }
+        }
+    };
+}
+
+ResultCache::ResultCache()
+{
+    setPersistent(cache::persistToDisk);
+}
+
+ResultCache::~ResultCache()
+{
+    if (persistent)
+        save();
+}
+
+juce::uint64 ResultCache::computeFingerprint(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, juce::uint64 analyser)
+{
+    const int blockSize = juce::jmax(1, juce::roundToInt(0.05 * sampleRate));
+    const int numChannels = buffer.getNumChannels();
+
+    Hasher hasher;
+    hasher.add(analyser);
+    hasher.add((juce::uint64)numSamples);
+    hasher.add((juce::uint64)juce::roundToInt(sampleRate));
+    hasher.add((juce::uint64)numChannels);
+
+    for (int start = 0; start + blockSize <= numSamples; start += blockSize)
+    {
+        //Level of each channel, 3 dB steps down to -120 dB, which all counts as silence.
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float energy = kernels::sumOfSquares(buffer.getReadPointer(channel, start), blockSize) / (float)blockSize;
+            const int step = juce::jlimit(-40, 0, (int)std::floor(10.0f * std::log10(energy + 1.0e-12f) / 3.0f));
+
+            hasher.add((juce::uint64)(step + 40));
+        }
+
+        //Side to mid ratio of each pair, 3 dB steps within +-60 dB. This is what a chorus changes.
+        for (int left = 0; left + 1 < numChannels; left += 2)
+        {
+            const float* l = buffer.getReadPointer(left, start);
+            const float* r = buffer.getReadPointer(left + 1, start);
+
+            const float sum = kernels::sumOfSquares(l, blockSize) + kernels::sumOfSquares(r, blockSize);
+            const float cross = 2.0f * kernels::dotProduct(l, r, blockSize);
+
+            const float ratio = (juce::jmax(0.0f, sum - cross) + 1.0e-12f) / (juce::jmax(0.0f, sum + cross) + 1.0e-12f);
+            const int step = juce::jlimit(-20, 20, (int)std::floor(10.0f * std::log10(ratio) / 3.0f));
+
+            hasher.add((juce::uint64)(step + 20));
+        }
+    }
+
+    return hasher.value;
+}
+
+int ResultCache::indexOf(juce::uint64 fingerprint, int backend) const
+{
+    for (int i = 0; i < entries.size(); ++i)
+        if (entries.getReference(i).fingerprint == fingerprint && entries.getReference(i).backend == backend)
+            return i;
+
+    return -1;
+}
+
+bool ResultCache::lookup(juce::uint64 fingerprint, int backend, float& result)
+{
+    const juce::ScopedLock sl(lock);
+    const int index = indexOf(fingerprint, backend);
+
+    if (index < 0)
+    {
+        ++misses;
+        return false;
+    }
+
+    auto& entry = entries.getReference(index);
+    entry.lastUsed = ++useCounter;
+    result = entry.result;
+
+    ++hits;
+    return true;
+}
+
+void ResultCache::store(juce::uint64 fingerprint, int backend, float result)
+{
+    const juce::ScopedLock sl(lock);
+    const int index = indexOf(fingerprint, backend);
+
+    if (index >= 0)
+    {
+        entries.getReference(index).result = result;
+        entries.getReference(index).lastUsed = ++useCounter;
+        return;
+    }
+
+    if (entries.size() >= cache::maxEntries)
+    {
+        int oldest = 0;
+
+        for (int i = 1; i < entries.size(); ++i)
+            if (entries.getReference(i).lastUsed < entries.getReference(oldest).lastUsed)
+                oldest = i;
+
+        entries.remove(oldest);
+    }
+
+    entries.add({ fingerprint, backend, result, ++useCounter });
+}
+
+void ResultCache::clear()
+{
+    const juce::ScopedLock sl(lock);
+    entries.clear();
+}
+
+ResultCache::Stats ResultCache::getStats() const
+{
+    Stats stats;
+    stats.hits = hits.load();
+    stats.misses = misses.load();
+
+    const juce::ScopedLock sl(lock);
+    stats.numEntries = entries.size();
+    return stats;
+}
+
+//==============================================================================
+juce::File ResultCache::getCacheFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile(cache::fileName);
+}
+
+void ResultCache::setPersistent(bool shouldPersist)
+{
+    const juce::ScopedLock sl(lock);
+
+    if (shouldPersist && ! persistent)
+        load();
+
+    persistent = shouldPersist;
+}
+
+bool ResultCache::load()
+{
+    juce::FileInputStream stream(getCacheFile());
+
+    if (! stream.openedOk() || stream.readInt() != fileMagic || stream.readInt() != fileVersion)
+        return false;
+
+    const int count = juce::jmin(stream.readInt(), cache::maxEntries);
+
+    for (int i = 0; i < count && ! stream.isExhausted(); ++i)
+    {
+        const auto fingerprint = (juce::uint64)stream.readInt64();
+        const int backend = stream.readInt();
+        const float result = stream.readFloat();
+
+        if (indexOf(fingerprint, backend) < 0)
+            entries.add({ fingerprint, backend, result, ++useCounter });
+    }
+
+    return true;
+}
+
+bool ResultCache::save() const
+{
+    const auto file = getCacheFile();
+
+    if (! file.getParentDirectory().createDirectory())
+        return false;
+
+    //Written next to the cache and swapped in, so a crash never leaves half a file.
+    juce::TemporaryFile temp(file);
+
+    {
+        juce::FileOutputStream stream(temp.getFile());
+
+        if (! stream.openedOk())
+            return false;
+
+        const juce::ScopedLock sl(lock);
+
+        stream.writeInt(fileMagic);
+        stream.writeInt(fileVersion);
+        stream.writeInt(entries.size());
+
+        for (const auto& entry : entries)
+        {
+            stream.writeInt64((juce::int64)entry.fingerprint);
+            stream.writeInt(entry.backend);
+            stream.writeFloat(entry.result);
+        }
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+            return false;
+    }
+
+    return temp.overwriteTargetFileWithTemporary();
+}
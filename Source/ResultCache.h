@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    ResultCache.h
+    Created: 18 Oct 2026 3:02:33pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Chorus results keyed by a fingerprint of the analysed audio.
+
+    The fingerprint is a 64-bit hash of the window's coarse contours in 50 ms
+    blocks: the level of every channel and the side to mid ratio of every
+    channel pair, both in 3 dB steps, together with its length and sample
+    rate. The same passage captured at the same position hits even through a
+    small amount of noise or gain rounding, but switching a chorus or a
+    widener on or off changes the side contour and misses. A window that
+    starts somewhere else in the song is a different passage and misses too.
+
+    The caller also hashes in the identity of the analyser (detector version,
+    model file, server or daemon), so a result is never reused for an
+    analyser that did not compute it.
+
+    One cache per process, shared by every instance through a
+    SharedResourcePointer. It keeps the most recently used entries up to
+    cache::maxEntries and can persist them to disk between sessions. Any thread
+    except the audio thread.
+*/
+class ResultCache
+{
+public:
+    ResultCache();
+    ~ResultCache();
+
+    static juce::uint64 computeFingerprint(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, juce::uint64 analyser);
+
+    //Results depend on the backend, so it is part of the key.
+    bool lookup(juce::uint64 fingerprint, int backend, float& result);
+    void store(juce::uint64 fingerprint, int backend, float result);
+
+    void clear();
+
+    //Persistence. Entries are loaded when enabled and written back on destruction.
+    void setPersistent(bool shouldPersist);
+    bool save() const;
+
+    struct Stats
+    {
+        juce::int64 hits = 0;
+        juce::int64 misses = 0;
+        int numEntries = 0;
+    };
+
+    Stats getStats() const;
+
+private:
+    struct Entry
+    {
+        juce::uint64 fingerprint;
+        int backend;
+        float result;
+        juce::uint64 lastUsed;
+    };
+
+    int indexOf(juce::uint64 fingerprint, int backend) const;
+    bool load();
+
+    static juce::File getCacheFile();
+
+    juce::CriticalSection lock;
+    juce::Array<Entry> entries;
+    juce::uint64 useCounter = 0;
+    bool persistent = false;
+
+    std::atomic<juce::int64> hits{ 0 };
+    std::atomic<juce::int64> misses{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ResultCache)
+};
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    SessionState.cpp
+    Created: 20 Oct 2026 10:41:17am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "SessionState.h"
+
+namespace
+{
+    //Header. The major version only changes when old readers could misread the sections.
+    static constexpr int stateMagic = 0x43465353; // "CFSS"
+    static constexpr int stateMajorVersion = 1;
+
+    enum SectionId
+    {
+        parametersSection = 1,
+        resultSection,
+        timelineSection
+    };
+
+    void writeSection(juce::MemoryOutputStream& stream, int id, const juce::MemoryOutputStream& payload)
+    {
+        stream.writeInt(id);
+        stream.writeInt((int)payload.getDataSize());
+        stream.write(payload.getData(), payload.getDataSize());
+    }
+}
+
+void SessionState::writeTo(juce::MemoryBlock& destData) const
+{
+    juce::MemoryOutputStream stream(destData, false);
+
+    stream.writeInt(stateMagic);
+    stream.writeInt(stateMajorVersion);
+
+    if (parameters.isValid())
+    {
+        juce::MemoryOutputStream payload;
+        parameters.writeToStream(payload);
+        writeSection(stream, parametersSection, payload);
+    }
+
+    if (hasResult)
+    {
+        juce::MemoryOutputStream payload;
+        payload.writeFloat(result);
+        payload.writeInt(resultBackend);
+        payload.writeInt64((juce::int64)resultFingerprint);
+        writeSection(stream, resultSection, payload);
+    }
+
+    if (! timeline.chorus.isEmpty())
+    {
+        juce::MemoryOutputStream payload;
+        payload.writeDouble(timeline.startSeconds);
+        payload.writeDouble(timeline.hopSeconds);
+        payload.writeDouble(timeline.windowSeconds);
+        payload.writeInt(timeline.chorus.size());
+
+        //Little-endian floats, NaN marks hops that were not analysed.
+        for (const auto value : timeline.chorus)
+            payload.writeFloat(value);
+
+        writeSection(stream, timelineSection, payload);
+    }
+}
+
+bool SessionState::readFrom(const void* data, int sizeInBytes)
+{
+    if (data == nullptr || sizeInBytes < 8)
+        return false;
+
+    juce::MemoryInputStream stream(data, (size_t)sizeInBytes, false);
+
+    if (stream.readInt() != stateMagic || stream.readInt() != stateMajorVersion)
+        return false;
+
+    while (stream.getNumBytesRemaining() >= 8)
+    {
+        const int id = stream.readInt();
+        const int size = stream.readInt();
+
+        if (size < 0 || size > stream.getNumBytesRemaining())
+            return false;
+
+        const auto sectionEnd = stream.getPosition() + size;
+        juce::MemoryInputStream payload((const char*)data + stream.getPosition(), (size_t)size, false);
+
+        switch (id)
+        {
+        case parametersSection:
+            parameters = juce::ValueTree::readFromStream(payload);
+            break;
+
+        case resultSection:
+            result = payload.readFloat();
+            resultBackend = payload.readInt();
+            resultFingerprint = (juce::uint64)payload.readInt64();
+            hasResult = payload.getPosition() == size && std::isfinite(result);
+            break;
+
+        case timelineSection:
+        {
+            timeline.startSeconds = payload.readDouble();
+            timeline.hopSeconds = payload.readDouble();
+            timeline.windowSeconds = payload.readDouble();
+
+            const int numHops = payload.readInt();
+
+            //A damaged count must not turn into a huge allocation.
+            if (numHops > 0 && (juce::int64)numHops * 4 <= payload.getNumBytesRemaining())
+            {
+                timeline.chorus.resize(numHops);
+
+                for (int i = 0; i < numHops; ++i)
+                    timeline.chorus.setUnchecked(i, payload.readFloat());
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        stream.setPosition(sectionEnd);
+    }
+
+    return true;
+}
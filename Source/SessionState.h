@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    SessionState.h
+    Created: 20 Oct 2026 10:41:17am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "ChorusTimeline.h"
+
+//==============================================================================
+/**
+    Everything an instance keeps in the host's project, in a compact binary form.
+
+    Layout: magic, version, then sections of [id, size, payload]. Readers skip
+    sections they do not know and sections that are missing keep their
+    defaults, so newer and older builds can open each other's projects. Only a
+    different magic or a newer major layout is rejected.
+
+    The parameters section is the APVTS tree (which also holds the API URL) in
+    ValueTree's binary format. The result section is the last applied
+    evaluation with its fingerprint, and the timeline section the whole-track
+    timeline as raw floats.
+*/
+struct SessionState
+{
+    juce::ValueTree parameters;
+
+    bool hasResult = false;
+    float result = 0.0f;
+    int resultBackend = 0;
+
+    //0 if the result did not come from an intact window.
+    juce::uint64 resultFingerprint = 0;
+
+    ChorusTimeline::Data timeline;
+
+    void writeTo(juce::MemoryBlock& destData) const;
+
+    //False if the data is not a session state this build can read.
+    bool readFrom(const void* data, int sizeInBytes);
+};
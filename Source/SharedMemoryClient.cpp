@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+    SharedMemoryClient.cpp
+    Created: 24 Oct 2026 10:14:52am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "SharedMemoryClient.h"
+#include "Config.h"
+#include "RealtimeChecks.h"
+
+using namespace daemonlayout;
+
+//==============================================================================
+DaemonConnection::DaemonConnection()
+    : juce::Thread("ChorusFind daemon mailbox")
+{
+    startThread(juce::Thread::Priority::normal);
+}
+
+DaemonConnection::~DaemonConnection()
+{
+    stopThread(2000);
+}
+
+juce::File DaemonConnection::getDefaultFile()
+{
+    const auto path = juce::SystemStats::getEnvironmentVariable(ipc::fileVariable, {});
+
+    if (juce::File::isAbsolutePath(path))
+        return juce::File(path);
+
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile(ipc::fileName);
+}
+
+bool DaemonConnection::ensureMapped(juce::String& error)
+{
+    if (header != nullptr && header->state.load(std::memory_order_acquire) == DaemonState::running)
+        return true;
+
+    //Remapping moves every slot, so only while nobody waits on one.
+    if (! waiting.isEmpty())
+    {
+        error = "The analysis daemon stopped.";
+        return false;
+    }
+
+    mapping.reset();
+    header = nullptr;
+    ++generation;
+
+    const auto file = getDefaultFile();
+
+    if (! file.existsAsFile())
+    {
+        error = "No analysis daemon file at " + file.getFullPathName();
+        return false;
+    }
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readWrite);
+
+    if (mapped->getData() == nullptr || mapped->getSize() < sizeof(DaemonHeader))
+    {
+        error = "Cannot map " + file.getFullPathName();
+        return false;
+    }
+
+    auto* candidate = static_cast<DaemonHeader*>(mapped->getData());
+
+    if (candidate->magic != daemonlayout::magic || candidate->version != daemonlayout::version)
+    {
+        error = file.getFullPathName() + " is not an analysis daemon file, or a newer version";
+        return false;
+    }
+
+    if (candidate->state.load(std::memory_order_acquire) != DaemonState::running)
+    {
+        error = "The analysis daemon is not running.";
+        return false;
+    }
+
+    const size_t audioBytes = (size_t)candidate->maxChannels * candidate->slotFrames * sizeof(float);
+
+    if (candidate->numSlots == 0 || candidate->maxChannels < 2 || candidate->slotBytes % 64 != 0
+        || candidate->slotBytes < sizeof(SlotHeader) + audioBytes
+        || mapped->getSize() < sizeof(DaemonHeader) + (size_t)candidate->numSlots * candidate->slotBytes)
+    {
+        error = file.getFullPathName() + " is damaged";
+        return false;
+    }
+
+    mapping = std::move(mapped);
+    header = candidate;
+    return true;
+}
+
+SlotHeader* DaemonConnection::getSlot(int index) const
+{
+    auto* slots = static_cast<char*>(mapping->getData()) + sizeof(DaemonHeader);
+    return reinterpret_cast<SlotHeader*>(slots + (size_t)index * header->slotBytes);
+}
+
+float* DaemonConnection::getAudio(int index, int channel) const
+{
+    auto* audio = reinterpret_cast<float*>(reinterpret_cast<char*>(getSlot(index)) + sizeof(SlotHeader));
+    return audio + (size_t)channel * header->slotFrames;
+}
+
+void DaemonConnection::run()
+{
+    std::vector<SharedMemoryClient::Completion> done;
+
+    while (! threadShouldExit())
+    {
+        bool idle;
+
+        {
+            //Taken before the lock, so a client cannot be cancelled between the two and miss the wait.
+            const juce::ScopedLock cl(callbackLock);
+
+            {
+                const juce::ScopedLock sl(lock);
+                const auto now = juce::Time::getMillisecondCounter();
+
+                for (int i = waiting.size(); --i >= 0;)
+                {
+                    SharedMemoryClient::Completion completion;
+
+                    if (waiting.getUnchecked(i)->poll(now, completion))
+                    {
+                        waiting.remove(i);
+                        done.push_back(std::move(completion));
+                    }
+                }
+
+                idle = waiting.isEmpty();
+            }
+
+            for (auto& completion : done)
+                completion.callback(completion.result);
+
+            done.clear();
+        }
+
+        //The daemon cannot wake this thread, so it polls while answers are due.
+        wait(idle ? -1 : ipc::pollIntervalMs);
+    }
+}
+
+//==============================================================================
+SharedMemoryClient::SharedMemoryClient() = default;
+
+SharedMemoryClient::~SharedMemoryClient()
+{
+    cancel(true);
+
+    const juce::ScopedLock sl(connection->lock);
+    releaseSlot();
+}
+
+void SharedMemoryClient::post(const juce::AudioBuffer<float>& window, int sampleRate, Callback onComplete)
+{
+    CHORUSFIND_RT_UNSAFE("SharedMemoryClient::post")
+
+    Result failure;
+
+    {
+        const juce::ScopedLock sl(connection->lock);
+        auto& daemon = *connection;
+
+        if (callback != nullptr)
+        {
+            failure.status = Result::Status::busy;
+            failure.message = "Still waiting for the previous window.";
+        }
+        else if (! daemon.ensureMapped(failure.message) || ! claimSlot(failure.message))
+        {
+            failure.status = Result::Status::unavailable;
+        }
+        else if (daemon.getSlot(slot)->responseSeq.load(std::memory_order_acquire) != daemon.getSlot(slot)->requestSeq.load(std::memory_order_relaxed))
+        {
+            //A request that timed out earlier is still being read.
+            failure.status = Result::Status::busy;
+            failure.message = "The analysis daemon is still busy with an earlier window.";
+        }
+        else if (window.getNumSamples() > (int)daemon.header->slotFrames || window.getNumChannels() < 1)
+        {
+            failure.status = Result::Status::unavailable;
+            failure.message = "The window does not fit the analysis daemon's slots.";
+        }
+        else
+        {
+            auto* mailbox = daemon.getSlot(slot);
+            const int numFrames = window.getNumSamples();
+
+            //A mono window is sent as two identical channels, as the uploads do.
+            for (int channel = 0; channel < 2; ++channel)
+                juce::FloatVectorOperations::copy(daemon.getAudio(slot, channel), window.getReadPointer(juce::jmin(channel, window.getNumChannels() - 1)), numFrames);
+
+            mailbox->numChannels = 2;
+            mailbox->numFrames = numFrames;
+            mailbox->sampleRate = sampleRate;
+
+            sequence = mailbox->requestSeq.load(std::memory_order_relaxed) + 1;
+            deadline = juce::Time::getMillisecondCounter() + (juce::uint32)ipc::timeoutMs;
+            startMs = juce::Time::getMillisecondCounterHiRes();
+            callback = std::move(onComplete);
+
+            //Publishes the frames and the description above.
+            mailbox->requestSeq.store(sequence, std::memory_order_release);
+
+            daemon.waiting.add(this);
+            daemon.notify();
+            return;
+        }
+    }
+
+    onComplete(failure);
+}
+
+void SharedMemoryClient::cancel(bool discardCallbacks)
+{
+    Callback pending;
+
+    {
+        const juce::ScopedLock sl(connection->lock);
+        connection->waiting.removeFirstMatchingValue(this);
+        pending = std::move(callback);
+        callback = nullptr;
+    }
+
+    //Waits for a callback of this client that the connection's thread is calling right now.
+    {
+        const juce::ScopedLock cl(connection->callbackLock);
+    }
+
+    if (pending != nullptr && ! discardCallbacks)
+    {
+        Result result;
+        result.status = Result::Status::cancelled;
+        pending(result);
+    }
+}
+
+bool SharedMemoryClient::poll(juce::uint32 now, Completion& done)
+{
+    auto& daemon = *connection;
+    auto* mailbox = daemon.getSlot(slot);
+
+    if (mailbox->responseSeq.load(std::memory_order_acquire) == sequence)
+    {
+        if (mailbox->status == SlotStatus::ok)
+            done = finish(Result::Status::ok, {}, juce::jlimit(0.0f, 1.0f, mailbox->result));
+        else
+            done = finish(Result::Status::daemonError, "The analysis daemon could not analyse the window (status " + juce::String(mailbox->status) + ").");
+
+        return true;
+    }
+
+    if (daemon.header->state.load(std::memory_order_acquire) != DaemonState::running)
+    {
+        done = finish(Result::Status::unavailable, "The analysis daemon stopped.");
+        return true;
+    }
+
+    if ((int)(deadline - now) <= 0)
+    {
+        done = finish(Result::Status::timedOut, "No answer within " + juce::String(ipc::timeoutMs) + " ms.");
+        return true;
+    }
+
+    return false;
+}
+
+SharedMemoryClient::Completion SharedMemoryClient::finish(Result::Status status, const juce::String& message, float value)
+{
+    Completion done;
+    done.result.status = status;
+    done.result.value = value;
+    done.result.message = message;
+    done.result.roundTripMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+
+    done.callback = std::move(callback);
+    callback = nullptr;
+    return done;
+}
+
+bool SharedMemoryClient::claimSlot(juce::String& error)
+{
+    auto& daemon = *connection;
+
+    if (slot >= 0 && slotGeneration == daemon.generation)
+        return true;
+
+    slot = -1;
+
+    if (token == 0)
+        token = (juce::uint32)juce::Random::getSystemRandom().nextInt() | 1u;
+
+    for (int i = 0; i < (int)daemon.header->numSlots; ++i)
+    {
+        juce::uint32 expected = 0;
+
+        if (daemon.getSlot(i)->owner.compare_exchange_strong(expected, token))
+        {
+            slot = i;
+            slotGeneration = daemon.generation;
+            return true;
+        }
+    }
+
+    error = "Every slot of the analysis daemon is in use.";
+    return false;
+}
+
+void SharedMemoryClient::releaseSlot()
+{
+    auto& daemon = *connection;
+
+    if (slot >= 0 && slotGeneration == daemon.generation && daemon.header != nullptr)
+    {
+        juce::uint32 expected = token;
+        daemon.getSlot(slot)->owner.compare_exchange_strong(expected, 0);
+    }
+
+    slot = -1;
+}
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    SharedMemoryClient.h
+    Created: 24 Oct 2026 10:14:52am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+class SharedMemoryClient;
+
+//==============================================================================
+/**
+    Layout of the file a local analysis daemon shares with the plugin, created
+    by the daemon (Tools/analysis_daemon.py) and mapped by every instance.
+
+        DaemonHeader, then numSlots slots of slotBytes each:
+            SlotHeader, then float audio[maxChannels][slotFrames]
+
+    All fields are little-endian 32-bit values at fixed offsets. An instance
+    claims a free slot by swapping its owner from 0 to a token, writes planar
+    frames and the window description into it and publishes the request by
+    bumping requestSeq. The daemon answers by writing status and result and
+    then setting responseSeq to requestSeq. Nothing is encoded or parsed on
+    either side.
+*/
+namespace daemonlayout
+{
+    static constexpr juce::uint32 magic = 0x4D534643; // "CFSM"
+    static constexpr juce::uint32 version = 1;
+
+    enum DaemonState : juce::uint32
+    {
+        stopped = 0,
+        running = 1
+    };
+
+    //Daemon status codes in SlotHeader::status.
+    enum SlotStatus : juce::int32
+    {
+        ok = 0,
+        rejected = 1,
+        failed = 2
+    };
+
+    struct DaemonHeader
+    {
+        juce::uint32 magic;
+        juce::uint32 version;
+        std::atomic<juce::uint32> state;
+        juce::uint32 numSlots;
+        juce::uint32 slotFrames;
+        juce::uint32 maxChannels;
+        juce::uint32 slotBytes;
+        juce::uint32 reserved[9];
+    };
+
+    struct SlotHeader
+    {
+        std::atomic<juce::uint32> owner;
+        std::atomic<juce::uint32> requestSeq;
+        std::atomic<juce::uint32> responseSeq;
+        juce::int32 numChannels;
+        juce::int32 numFrames;
+        juce::int32 sampleRate;
+        juce::int32 status;
+        float result;
+        juce::uint32 reserved[8];
+    };
+
+    static_assert(std::atomic<juce::uint32>::is_always_lock_free, "The mailbox needs lock-free 32-bit atomics");
+    static_assert(sizeof(DaemonHeader) == 64 && sizeof(SlotHeader) == 64, "Offsets are shared with the daemon");
+}
+
+//==============================================================================
+/**
+    The daemon's shared file, mapped once per process and shared by all
+    SharedMemoryClients through a SharedResourcePointer.
+
+    Its thread polls the mailboxes of the requests in flight every
+    ipc::pollIntervalMs and sleeps while there are none. A daemon that stops
+    marks its file stopped, the next request then maps the new one.
+
+    Completed requests are collected under the lock and their callbacks are
+    called after it has been released, holding only callbackLock. A client
+    being cancelled waits on callbackLock, so no callback runs after its
+    owner has gone, and nothing a callback does can block the lock that
+    post() and cancel() take.
+*/
+class DaemonConnection : private juce::Thread
+{
+public:
+    DaemonConnection();
+    ~DaemonConnection() override;
+
+    static juce::File getDefaultFile();
+
+private:
+    friend class SharedMemoryClient;
+
+    void run() override;
+
+    //Called with the lock held.
+    bool ensureMapped(juce::String& error);
+    daemonlayout::SlotHeader* getSlot(int index) const;
+    float* getAudio(int index, int channel) const;
+
+    juce::CriticalSection lock;
+    juce::CriticalSection callbackLock;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    daemonlayout::DaemonHeader* header = nullptr;
+
+    //Bumped on every remap, so clients know their slot is gone.
+    int generation = 0;
+
+    juce::Array<SharedMemoryClient*> waiting;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DaemonConnection)
+};
+
+//==============================================================================
+/**
+    Sends analysis windows to the local daemon through shared memory.
+
+    Each processor owns one and claims a daemon slot on its first request,
+    keeping it until it is destroyed. post() copies the frames straight into
+    the slot and returns, the outcome arrives on the connection's thread.
+    Unlike AnalysisClient a request is never replaced in flight: the daemon
+    may still be reading the slot, so a new request while the previous one is
+    unanswered fails with Status::busy.
+*/
+class SharedMemoryClient
+{
+public:
+    struct Result
+    {
+        enum class Status
+        {
+            ok,
+            timedOut,
+            cancelled,
+            unavailable,
+            busy,
+            daemonError
+        };
+
+        Status status = Status::unavailable;
+        float value = 0.5f;
+        double roundTripMs = 0.0;
+        juce::String message;
+
+        bool succeeded() const { return status == Status::ok; }
+    };
+
+    using Callback = std::function<void(const Result&)>;
+
+    SharedMemoryClient();
+    ~SharedMemoryClient();
+
+    //Sends the first two channels of window. onComplete is called on the connection's
+    //thread, or on the calling thread when the request could not be sent at all.
+    void post(const juce::AudioBuffer<float>& window, int sampleRate, Callback onComplete);
+
+    //Stops waiting for the request in flight. With discardCallbacks its callback is not called.
+    void cancel(bool discardCallbacks = false);
+
+private:
+    friend class DaemonConnection;
+
+    //A finished request, its callback is called once the connection's lock is released.
+    struct Completion
+    {
+        Callback callback;
+        Result result;
+    };
+
+    //Connection thread, with the connection's lock held. True once the request is complete.
+    bool poll(juce::uint32 now, Completion& done);
+    Completion finish(Result::Status status, const juce::String& message, float value = 0.5f);
+
+    //Called with the connection's lock held.
+    bool claimSlot(juce::String& error);
+    void releaseSlot();
+
+    juce::SharedResourcePointer<DaemonConnection> connection;
+
+    //Guarded by the connection's lock
+    int slot = -1;
+    int slotGeneration = -1;
+    juce::uint32 token = 0;
+    juce::uint32 sequence = 0;
+    juce::uint32 deadline = 0;
+    double startMs = 0.0;
+    Callback callback;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SharedMemoryClient)
+};
@@ -9,6 +9,7 @@
 */
 
 #pragma once
+#include <atomic>
 
 enum PluginState {
     READY,
@@ -17,39 +18,48 @@ enum PluginState {
     BACKGROUND
 };
 
+//Lock-free evaluation state, READY -> LISTENING -> CALCULATING -> BACKGROUND -> READY.
+//Every transition has exactly one owning thread:
+//  READY -> LISTENING, LISTENING -> CALCULATING    audio thread
+//  CALCULATING -> BACKGROUND, BACKGROUND -> READY  message thread
+//Other threads only read the state and talk to the owners through queues.
 class State
 {
 private:
-    PluginState currState;
+    std::atomic<PluginState> currState;
+
+    static_assert(std::atomic<PluginState>::is_always_lock_free, "State must be lock-free for the audio thread");
 public:
     State()
     {
         currState = PluginState::READY;
     }
 
-    PluginState getPluginState()
+    PluginState getPluginState() const
     {
-        return currState;
+        return currState.load(std::memory_order_acquire);
     }
 
-    void goToNextState()
+    static PluginState getNextState(PluginState state)
     {
-        switch (currState)
+        switch (state)
         {
         case READY:
-            currState = LISTENING;
-            break;
+            return LISTENING;
         case LISTENING:
-            currState = CALCULATING;
-            break;
+            return CALCULATING;
         case CALCULATING:
-            currState = BACKGROUND;
-            break;
+            return BACKGROUND;
         case BACKGROUND:
-            currState = READY;
-            break;
+            return READY;
         default:
-            break;
+            return READY;
         }
     }
-};
+
+    //Moves on to the next state only if the state is still 'from'.
+    bool goToNextState(PluginState from)
+    {
+        return currState.compare_exchange_strong(from, getNextState(from), std::memory_order_acq_rel);
+    }
+};
\ No newline at end of file
@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+    StereoMeter.cpp
+    Created: 21 Oct 2026 3:06:45pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "StereoMeter.h"
+#include "AnalysisKernels.h"
+
+namespace
+{
+    constexpr double hopSeconds = 0.01;
+
+    //Time constants of the correlation and of the modulation depth.
+    constexpr double smoothingSeconds = 0.3;
+    constexpr double memorySeconds = 2.0;
+
+    //LFO band, as in ChorusDetector.
+    constexpr double lfoLowHz = 0.2;
+    constexpr double lfoHighHz = 8.0;
+    constexpr int warmUpHops = 5;
+
+    //Mean square per sample below which a hop counts as silence.
+    constexpr float silenceMeanSquare = 1.0e-7f;
+
+    //Heuristic mapping to 0-1.
+    constexpr float weightDecorrelation = 0.8f;
+    constexpr float weightModulation = 3.0f;
+
+    float coefficientFor(double seconds)
+    {
+        return (float)(1.0 - std::exp(-hopSeconds / seconds));
+    }
+}
+
+void StereoMeter::prepare(double sampleRate)
+{
+    hopSize = juce::jmax(1, juce::roundToInt(hopSeconds * sampleRate));
+
+    smoothing = coefficientFor(smoothingSeconds);
+    memory = coefficientFor(memorySeconds);
+    lowCoeff = (float)std::exp(-juce::MathConstants<double>::twoPi * lfoHighHz * hopSeconds);
+    highCoeff = (float)std::exp(-juce::MathConstants<double>::twoPi * lfoLowHz * hopSeconds);
+
+    //Resolves the kernel set here rather than on the first audio block.
+    kernels::get();
+
+    reset();
+}
+
+void StereoMeter::reset()
+{
+    hopFill = 0;
+    hopLL = hopRR = hopLR = 0.0f;
+
+    smoothLL = smoothRR = smoothLR = 0.0;
+    lowState = highState = modulationSquare = 0.0f;
+    warmUp = 0;
+    numHops = 0;
+
+    publish({});
+}
+
+void StereoMeter::process(const float* left, const float* right, int numSamples) noexcept
+{
+    while (numSamples > 0)
+    {
+        const int numToAdd = juce::jmin(numSamples, hopSize - hopFill);
+
+        hopLL += kernels::sumOfSquares(left, numToAdd);
+        hopRR += kernels::sumOfSquares(right, numToAdd);
+        hopLR += kernels::dotProduct(left, right, numToAdd);
+
+        left += numToAdd;
+        right += numToAdd;
+        numSamples -= numToAdd;
+
+        if ((hopFill += numToAdd) == hopSize)
+            finishHop();
+    }
+}
+
+void StereoMeter::finishHop() noexcept
+{
+    const float ll = hopLL;
+    const float rr = hopRR;
+    const float lr = hopLR;
+
+    hopFill = 0;
+    hopLL = hopRR = hopLR = 0.0f;
+
+    if (ll + rr < 2.0f * silenceMeanSquare * hopSize)
+        return;
+
+    smoothLL += smoothing * (ll - smoothLL);
+    smoothRR += smoothing * (rr - smoothRR);
+    smoothLR += smoothing * (lr - smoothLR);
+
+    const double total = smoothLL + smoothRR;
+    const float smoothCorrelation = (float)(smoothLR / std::sqrt(smoothLL * smoothRR + 1.0e-20));
+
+    //M = (L + R) / 2 and S = (L - R) / 2, so S.S / (M.M + S.S) needs no extra pass.
+    const float side = (float)((total - 2.0 * smoothLR) / (2.0 * total + 1.0e-20));
+
+    //The image's movement: band-passed correlation of single hops.
+    const float hopCorrelation = lr / std::sqrt(ll * rr + 1.0e-20f);
+
+    if (warmUp == 0)
+        lowState = highState = hopCorrelation;
+
+    lowState = hopCorrelation + lowCoeff * (lowState - hopCorrelation);
+    highState = hopCorrelation + highCoeff * (highState - hopCorrelation);
+
+    if (warmUp < warmUpHops)
+    {
+        ++warmUp;
+    }
+    else
+    {
+        const float band = lowState - highState;
+        modulationSquare += memory * (band * band - modulationSquare);
+    }
+
+    const float depth = std::sqrt(modulationSquare);
+
+    publish({ juce::jlimit(-1.0f, 1.0f, smoothCorrelation),
+              juce::jlimit(0.0f, 1.0f, side),
+              depth,
+              juce::jlimit(0.0f, 1.0f, weightDecorrelation * (1.0f - juce::jmax(0.0f, smoothCorrelation)) + weightModulation * depth),
+              ++numHops });
+}
+
+void StereoMeter::publish(const Values& values) noexcept
+{
+    //Single writer. The fence keeps the field stores after the odd count.
+    const auto start = sequence.load(std::memory_order_relaxed);
+    sequence.store(start + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    correlation.store(values.correlation, std::memory_order_relaxed);
+    sideRatio.store(values.sideRatio, std::memory_order_relaxed);
+    modulation.store(values.modulation, std::memory_order_relaxed);
+    indicator.store(values.indicator, std::memory_order_relaxed);
+    publishedHops.store(values.numHops, std::memory_order_relaxed);
+
+    sequence.store(start + 2, std::memory_order_release);
+}
+
+StereoMeter::Values StereoMeter::getValues() const noexcept
+{
+    for (;;)
+    {
+        const auto before = sequence.load(std::memory_order_acquire);
+
+        Values values { correlation.load(std::memory_order_relaxed),
+                        sideRatio.load(std::memory_order_relaxed),
+                        modulation.load(std::memory_order_relaxed),
+                        indicator.load(std::memory_order_relaxed),
+                        publishedHops.load(std::memory_order_relaxed) };
+
+        //The fence keeps the field loads before the second look at the count.
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if ((before & 1) == 0 && sequence.load(std::memory_order_relaxed) == before)
+            return values;
+    }
+}
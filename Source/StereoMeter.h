@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    StereoMeter.h
+    Created: 21 Oct 2026 3:06:45pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Running stereo-image features, cheap enough for every processBlock.
+
+    Input is cut into 10 ms hops. Each hop costs three vector kernels (L.L,
+    R.R and L.R), and everything else is derived from those sums once per hop:
+      - L/R correlation, smoothed over a few hundred milliseconds,
+      - side share of the total energy, (S.S) / (M.M + S.S),
+      - modulation: depth of the per-hop correlation at LFO rates (0.2 - 8 Hz).
+    A chorus widens the image and makes it move, so a low correlation together
+    with modulation gives a rough chorus indicator without any capture window.
+
+    Silent hops are skipped, the values hold until there is signal again.
+    process() never allocates or locks. Each hop publishes all values together
+    behind a sequence counter, so getValues() on any thread returns one
+    consistent set, never a mix of two hops. The continuous mode uses the
+    indicator as a prior while its detector warms up.
+*/
+class StereoMeter
+{
+public:
+    struct Values
+    {
+        float correlation = 1.0f;
+        float sideRatio = 0.0f;
+        float modulation = 0.0f;
+
+        //0-1, same range as paramChorusAmount but a far rougher estimate.
+        float indicator = 0.0f;
+
+        //Hops with signal since reset(), the values mean little for the first few.
+        int numHops = 0;
+    };
+
+    StereoMeter() = default;
+
+    //Call while process() cannot run.
+    void prepare(double sampleRate);
+    void reset();
+
+    //Audio thread only.
+    void process(const float* left, const float* right, int numSamples) noexcept;
+
+    //Any thread. Retries while a hop is being published, which takes a few stores.
+    Values getValues() const noexcept;
+
+private:
+    void finishHop() noexcept;
+    void publish(const Values& values) noexcept;
+
+    int hopSize = 1;
+    int hopFill = 0;
+    float hopLL = 0.0f;
+    float hopRR = 0.0f;
+    float hopLR = 0.0f;
+
+    //Exponential averages per hop.
+    float smoothing = 1.0f;
+    float memory = 1.0f;
+    float lowCoeff = 0.0f;
+    float highCoeff = 0.0f;
+
+    double smoothLL = 0.0;
+    double smoothRR = 0.0;
+    double smoothLR = 0.0;
+
+    //LFO band-pass of the per-hop correlation.
+    float lowState = 0.0f;
+    float highState = 0.0f;
+    float modulationSquare = 0.0f;
+    int warmUp = 0;
+    int numHops = 0;
+
+    //Seqlock: odd while publish() is writing the fields.
+    std::atomic<juce::uint32> sequence{ 0 };
+    std::atomic<float> correlation{ 1.0f };
+    std::atomic<float> sideRatio{ 0.0f };
+    std::atomic<float> modulation{ 0.0f };
+    std::atomic<float> indicator{ 0.0f };
+    std::atomic<int> publishedHops{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StereoMeter)
+};
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    StreamingAnalyser.cpp
+    Created: 17 Oct 2026 3:48:27pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "StreamingAnalyser.h"
+#include "Config.h"
+
+StreamingAnalyser::StreamingAnalyser(const CaptureRingBuffer& ringToFollow, const StereoMeter& meterToUse)
+    : juce::Thread("ChorusFind streaming analyser")
+    , ring(ringToFollow)
+    , meter(meterToUse)
+{
+}
+
+StreamingAnalyser::~StreamingAnalyser()
+{
+    stopThread(2000);
+}
+
+void StreamingAnalyser::prepare(double sampleRate)
+{
+    jassert(! isThreadRunning());
+
+    detector.prepare(sampleRate);
+    detector.setMemorySeconds(streaming::memorySeconds);
+
+    memorySamples = (int)(streaming::memorySeconds * sampleRate);
+    bufChunk.setSize(2, (int)(streaming::chunkSeconds * sampleRate));
+    following = false;
+}
+
+void StreamingAnalyser::setActive(bool shouldBeActive) noexcept
+{
+    if (active.exchange(shouldBeActive) != shouldBeActive && shouldBeActive)
+        notify();
+}
+
+void StreamingAnalyser::restartFrom(juce::int64 position)
+{
+    //Warm up from the history that is already in the ring.
+    detector.reset();
+    readPosition = juce::jmax((juce::int64)0, position - memorySamples);
+    following = true;
+}
+
+void StreamingAnalyser::run()
+{
+    while (! threadShouldExit())
+    {
+        if (! active.load())
+        {
+            following = false;
+            wait(-1);
+            continue;
+        }
+
+        const auto written = ring.getTotalWritten();
+
+        if (! following)
+            restartFrom(written);
+
+        while (readPosition < written && ! threadShouldExit())
+        {
+            const int numSamples = (int)juce::jmin((juce::int64)bufChunk.getNumSamples(), written - readPosition);
+
+            if (! ring.copyRange(bufChunk, readPosition, numSamples))
+            {
+                //Fell more than a ring behind, start over from the present.
+                restartFrom(ring.getTotalWritten());
+                break;
+            }
+
+            detector.pushSamples(bufChunk.getReadPointer(0), bufChunk.getReadPointer(1), numSamples);
+            readPosition += numSamples;
+        }
+
+        //One consistent snapshot of the meter, taken once per refresh.
+        const auto prior = meter.getValues();
+        const bool hasPrior = prior.numHops >= streaming::priorMinHops;
+
+        if (onEstimate != nullptr && detector.hasEstimate())
+            onEstimate(hasPrior ? juce::jmap(streaming::priorWeight, detector.getChorusAmount(), prior.indicator) : detector.getChorusAmount());
+        else if (onEstimate != nullptr && hasPrior)
+            onEstimate(prior.indicator);
+
+        wait(streaming::refreshIntervalMs);
+    }
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    StreamingAnalyser.h
+    Created: 17 Oct 2026 3:48:27pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "CaptureBuffer.h"
+#include "ChorusDetector.h"
+#include "StereoMeter.h"
+
+//==============================================================================
+/**
+    Background worker for the continuous mode.
+
+    While active it follows the capture ring, feeds every new hop into its own
+    ChorusDetector and reports the running estimate several times per second.
+    Only new audio is analysed on each pass; the detector keeps exponentially
+    decaying statistics over the last few seconds instead of re-reading a window.
+
+    The StereoMeter's indicator is a cheap prior: it is reported on its own
+    until the detector has a first estimate, and blended in with
+    streaming::priorWeight after that.
+*/
+class StreamingAnalyser : public juce::Thread
+{
+public:
+    StreamingAnalyser(const CaptureRingBuffer& ringToFollow, const StereoMeter& meterToUse);
+    ~StreamingAnalyser() override;
+
+    //Call while the thread is stopped.
+    void prepare(double sampleRate);
+
+    //Cheap enough to call from processBlock.
+    void setActive(bool shouldBeActive) noexcept;
+
+    //Called on this thread with each refreshed 0-1 estimate.
+    std::function<void(float)> onEstimate;
+
+    void run() override;
+
+private:
+    void restartFrom(juce::int64 position);
+
+    const CaptureRingBuffer& ring;
+    const StereoMeter& meter;
+    ChorusDetector detector;
+    juce::AudioBuffer<float> bufChunk;
+
+    std::atomic<bool> active{ false };
+    bool following = false;
+    juce::int64 readPosition = 0;
+    int memorySamples = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StreamingAnalyser)
+};
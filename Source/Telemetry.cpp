@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    Telemetry.cpp
+    Created: 19 Oct 2026 10:12:48am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "Telemetry.h"
+
+namespace
+{
+    std::atomic<int> nextInstanceId{ 1 };
+}
+
+Telemetry::Telemetry()
+    : instanceId(nextInstanceId++)
+{
+    reset();
+}
+
+//==============================================================================
+Telemetry::ScopedBlockTimer::ScopedBlockTimer(Telemetry& owner, int numSamples, double sampleRate) noexcept
+    : telemetry(owner)
+    , startTicks(juce::Time::getHighResolutionTicks())
+    , blockSeconds(sampleRate > 0.0 ? numSamples / sampleRate : 0.0)
+{
+}
+
+Telemetry::ScopedBlockTimer::~ScopedBlockTimer() noexcept
+{
+    telemetry.addBlock(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks), blockSeconds);
+}
+
+//==============================================================================
+void Telemetry::addBlock(double seconds, double blockSeconds) noexcept
+{
+    if (blockSeconds <= 0.0)
+        return;
+
+    const float load = (float)(100.0 * seconds / blockSeconds);
+    int bucket = 0;
+
+    while (bucket < numLoadBuckets - 1 && load > loadBucketEdges[bucket])
+        ++bucket;
+
+    loadHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    numBlocks.fetch_add(1, std::memory_order_relaxed);
+    lastLoad.store(load, std::memory_order_relaxed);
+    raiseTo(maxLoad, load);
+}
+
+void Telemetry::record(TimingCounters& counters, double ms) noexcept
+{
+    counters.totalMicroseconds.fetch_add((juce::uint64)(ms * 1000.0), std::memory_order_relaxed);
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.lastMs.store((float)ms, std::memory_order_relaxed);
+    raiseTo(counters.maxMs, (float)ms);
+}
+
+void Telemetry::raiseTo(std::atomic<float>& value, float candidate) noexcept
+{
+    auto current = value.load(std::memory_order_relaxed);
+
+    while (candidate > current && ! value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+    {
+    }
+}
+
+Telemetry::Timing Telemetry::read(const TimingCounters& counters) noexcept
+{
+    Timing timing;
+    timing.count = counters.count.load(std::memory_order_relaxed);
+    timing.lastMs = counters.lastMs.load(std::memory_order_relaxed);
+    timing.maxMs = counters.maxMs.load(std::memory_order_relaxed);
+
+    if (timing.count > 0)
+        timing.meanMs = (float)(counters.totalMicroseconds.load(std::memory_order_relaxed) / 1000.0 / timing.count);
+
+    return timing;
+}
+
+Telemetry::Snapshot Telemetry::getSnapshot() const noexcept
+{
+    Snapshot snapshot;
+
+    for (int i = 0; i < numLoadBuckets; ++i)
+        snapshot.loadHistogram[i] = loadHistogram[i].load(std::memory_order_relaxed);
+
+    snapshot.numBlocks = numBlocks.load(std::memory_order_relaxed);
+    snapshot.lastLoad = lastLoad.load(std::memory_order_relaxed);
+    snapshot.maxLoad = maxLoad.load(std::memory_order_relaxed);
+    snapshot.analysis = read(analysis);
+    snapshot.roundTrip = read(roundTrip);
+    return snapshot;
+}
+
+void Telemetry::reset() noexcept
+{
+    for (auto& bucket : loadHistogram)
+        bucket.store(0, std::memory_order_relaxed);
+
+    numBlocks.store(0, std::memory_order_relaxed);
+    lastLoad.store(0.0f, std::memory_order_relaxed);
+    maxLoad.store(0.0f, std::memory_order_relaxed);
+
+    for (auto* counters : { &analysis, &roundTrip })
+    {
+        counters->count.store(0, std::memory_order_relaxed);
+        counters->totalMicroseconds.store(0, std::memory_order_relaxed);
+        counters->lastMs.store(0.0f, std::memory_order_relaxed);
+        counters->maxMs.store(0.0f, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+juce::String Telemetry::Snapshot::toJson(int instanceId) const
+{
+    const auto timingToVar = [](const Timing& timing)
+    {
+        auto* object = new juce::DynamicObject();
+        object->setProperty("count", (int)timing.count);
+        object->setProperty("lastMs", timing.lastMs);
+        object->setProperty("meanMs", timing.meanMs);
+        object->setProperty("maxMs", timing.maxMs);
+        return juce::var(object);
+    };
+
+    juce::Array<juce::var> histogram;
+
+    for (const auto count : loadHistogram)
+        histogram.add((int)count);
+
+    auto* object = new juce::DynamicObject();
+    object->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    object->setProperty("instance", instanceId);
+    object->setProperty("blocks", (juce::int64)numBlocks);
+    object->setProperty("loadHistogram", histogram);
+    object->setProperty("lastLoadPct", lastLoad);
+    object->setProperty("maxLoadPct", maxLoad);
+    object->setProperty("ringFill", ringFill);
+    object->setProperty("windowFill", windowFill);
+    object->setProperty("commandQueue", commandQueueDepth);
+    object->setProperty("resultQueue", resultQueueDepth);
+    object->setProperty("jobQueue", jobQueueDepth);
+    object->setProperty("offlinePending", offlinePending);
+    object->setProperty("analysis", timingToVar(analysis));
+    object->setProperty("roundTrip", timingToVar(roundTrip));
+
+    //One line per snapshot, so the file can be read as JSON lines.
+    return juce::JSON::toString(juce::var(object), true);
+}
+
+bool Telemetry::appendToMetricsFile(const juce::File& file, const juce::String& line)
+{
+    static juce::CriticalSection fileLock;
+    const juce::ScopedLock sl(fileLock);
+
+    juce::FileOutputStream stream(file);
+
+    if (! stream.openedOk())
+        return false;
+
+    stream << line << juce::newLine;
+    return stream.getStatus().wasOk();
+}
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    Telemetry.h
+    Created: 19 Oct 2026 10:12:48am
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+
+//==============================================================================
+/**
+    Per-instance performance counters.
+
+    Every counter is a relaxed atomic, so the audio thread and the workers
+    record without locks or allocation and the message thread reads a
+    Snapshot whenever it wants. Values read together may come from slightly
+    different moments, which is fine for a diagnostics display.
+
+    processBlock time is kept as a histogram of the load, the time spent in
+    the block relative to the block's duration, so block sizes and sample
+    rates can be compared.
+*/
+class Telemetry
+{
+public:
+    //Upper bucket edges of the load histogram, in percent of the block duration. The last bucket is open.
+    static constexpr int numLoadBuckets = 8;
+    static constexpr float loadBucketEdges[numLoadBuckets - 1] = { 1.0f, 2.0f, 5.0f, 10.0f, 25.0f, 50.0f, 100.0f };
+
+    struct Timing
+    {
+        juce::uint32 count = 0;
+        float lastMs = 0.0f;
+        float meanMs = 0.0f;
+        float maxMs = 0.0f;
+    };
+
+    struct Snapshot
+    {
+        juce::uint32 loadHistogram[numLoadBuckets] = {};
+        juce::uint64 numBlocks = 0;
+        float lastLoad = 0.0f;
+        float maxLoad = 0.0f;
+
+        Timing analysis;
+        Timing roundTrip;
+
+        //Sampled by the processor when the snapshot is taken.
+        float ringFill = 0.0f;
+        float windowFill = 0.0f;
+        int commandQueueDepth = 0;
+        int resultQueueDepth = 0;
+        int jobQueueDepth = 0;
+        int offlinePending = 0;
+
+        juce::String toJson(int instanceId) const;
+    };
+
+    Telemetry();
+
+    //Times one processBlock call. Audio thread only.
+    class ScopedBlockTimer
+    {
+    public:
+        ScopedBlockTimer(Telemetry& owner, int numSamples, double sampleRate) noexcept;
+        ~ScopedBlockTimer() noexcept;
+
+    private:
+        Telemetry& telemetry;
+        const juce::int64 startTicks;
+        const double blockSeconds;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlockTimer)
+    };
+
+    //Any thread, never blocks or allocates.
+    void addAnalysisTime(double ms) noexcept { record(analysis, ms); }
+    void addRoundTrip(double ms) noexcept { record(roundTrip, ms); }
+
+    //Counters only, the processor fills in the sampled fields.
+    Snapshot getSnapshot() const noexcept;
+
+    //Message thread. Resets the counters, not the sampled fields.
+    void reset() noexcept;
+
+    int getInstanceId() const noexcept { return instanceId; }
+
+    //Appends one JSON line to file. Any thread except the audio thread, writes from all instances are serialised.
+    static bool appendToMetricsFile(const juce::File& file, const juce::String& line);
+
+private:
+    struct TimingCounters
+    {
+        std::atomic<juce::uint32> count{ 0 };
+        std::atomic<juce::uint64> totalMicroseconds{ 0 };
+        std::atomic<float> lastMs{ 0.0f };
+        std::atomic<float> maxMs{ 0.0f };
+    };
+
+    void addBlock(double seconds, double blockSeconds) noexcept;
+    static void record(TimingCounters& counters, double ms) noexcept;
+    static void raiseTo(std::atomic<float>& value, float candidate) noexcept;
+    static Timing read(const TimingCounters& counters) noexcept;
+
+    std::atomic<juce::uint32> loadHistogram[numLoadBuckets];
+    std::atomic<juce::uint64> numBlocks{ 0 };
+    std::atomic<float> lastLoad{ 0.0f };
+    std::atomic<float> maxLoad{ 0.0f };
+
+    TimingCounters analysis;
+    TimingCounters roundTrip;
+
+    const int instanceId;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Telemetry)
+};
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    TransportTracker.h
+    Created: 18 Oct 2026 6:12:48pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Follows the host transport and maps its bar grid onto capture ring positions.
+
+    update() is called once per block with the host position and the ring
+    position of the block's first sample. It remembers where the current run of
+    continuous playback began (transport start, locate, loop jump, tempo or
+    metre change) and where the last bar line fell, so findBarWindow() can
+    place a window of whole bars that lies entirely inside that run.
+
+    Audio thread only, nothing here allocates.
+*/
+class TransportTracker
+{
+public:
+    void prepare(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        playing = false;
+        continuousSince = 0;
+    }
+
+    void update(const juce::Optional<juce::AudioPlayHead::PositionInfo>& position, juce::int64 blockStart, int numSamples) noexcept
+    {
+        if (! position.hasValue() || ! position->getIsPlaying())
+        {
+            playing = false;
+            return;
+        }
+
+        const auto ppq = position->getPpqPosition();
+        const auto barStart = position->getPpqPositionOfLastBarStart();
+        const auto bpm = position->getBpm();
+        const auto timeSignature = position->getTimeSignature();
+
+        const bool hasGrid = ppq && barStart && bpm && timeSignature
+                          && *bpm > 0.0 && timeSignature->numerator > 0 && timeSignature->denominator > 0;
+
+        if (! hasGrid)
+        {
+            playing = false;
+            return;
+        }
+
+        const double newSamplesPerBeat = sampleRate * 60.0 / *bpm;
+        const double newBeatsPerBar = timeSignature->numerator * 4.0 / timeSignature->denominator;
+
+        //Anything but the expected continuation starts a new run.
+        const bool continuous = playing
+                             && std::abs(*ppq - expectedPpq) < 1.0e-3
+                             && std::abs(newSamplesPerBeat - samplesPerBeat) < 1.0e-6 * samplesPerBeat
+                             && newBeatsPerBar == beatsPerBar;
+
+        if (! continuous)
+            continuousSince = blockStart;
+
+        playing = true;
+        samplesPerBeat = newSamplesPerBeat;
+        beatsPerBar = newBeatsPerBar;
+        lastBarPosition = (double)blockStart + (*barStart - *ppq) * samplesPerBeat;
+        expectedPpq = *ppq + numSamples / samplesPerBeat;
+    }
+
+    bool isPlaying() const noexcept { return playing; }
+
+    //Finds the latest window of numBars whole bars (fewer if they do not fit in maxWindowSamples)
+    //that starts inside the current run. The end can lie in the future, the capture then waits for it.
+    bool findBarWindow(int numBars, int maxWindowSamples, juce::int64& end, int& windowSamples) const noexcept
+    {
+        if (! playing)
+            return false;
+
+        const double samplesPerBar = samplesPerBeat * beatsPerBar;
+        const int bars = juce::jmin(numBars, (int)(maxWindowSamples / samplesPerBar));
+
+        if (bars < 1)
+            return false;
+
+        const double length = bars * samplesPerBar;
+
+        //Latest bar line that has a whole window of this run before it, or the first one after that.
+        const double barsFromLast = std::ceil(((double)continuousSince + length - lastBarPosition) / samplesPerBar - 1.0e-9);
+        const double endPosition = lastBarPosition + juce::jmax(0.0, barsFromLast) * samplesPerBar;
+
+        end = (juce::int64)std::llround(endPosition);
+        windowSamples = (int)std::llround(length);
+        return true;
+    }
+
+private:
+    double sampleRate = 44100.0;
+
+    bool playing = false;
+    double samplesPerBeat = 0.0;
+    double beatsPerBar = 4.0;
+    double expectedPpq = 0.0;
+
+    //Ring position of the last bar line and of the start of the current run.
+    double lastBarPosition = 0.0;
+    juce::int64 continuousSince = 0;
+};
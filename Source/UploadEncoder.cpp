@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    UploadEncoder.cpp
+    Created: 19 Oct 2026 5:18:02pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "UploadEncoder.h"
+#include "RealtimeChecks.h"
+
+bool UploadEncoder::encode(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, int format, bool downmixToMid)
+{
+    CHORUSFIND_RT_UNSAFE("UploadEncoder::encode")
+
+    lastWasFlac = format == UploadFormat::FLAC;
+
+    switch (format)
+    {
+    case UploadFormat::WAV_24:  return wavEncoder.encode(buffer, numSamples, sampleRate, 24, downmixToMid);
+    case UploadFormat::WAV_16:  return wavEncoder.encode(buffer, numSamples, sampleRate, 16, downmixToMid);
+    case UploadFormat::FLAC:    return encodeFlac(buffer, numSamples, sampleRate, downmixToMid);
+    default:                    return false;
+    }
+}
+
+bool UploadEncoder::encodeFlac(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, bool downmixToMid)
+{
+    const juce::AudioBuffer<float>* source = &buffer;
+
+    if (downmixToMid && buffer.getNumChannels() > 1)
+    {
+        //Grows once per window length, like the encoded blocks.
+        bufMid.setSize(1, numSamples, false, false, true);
+        bufMid.copyFrom(0, 0, buffer, 0, 0, numSamples);
+        bufMid.addFrom(0, 0, buffer, 1, 0, numSamples);
+        bufMid.applyGain(0.5f);
+        source = &bufMid;
+    }
+
+    //The stream writes from the start of the block and trims it to the encoded size when the writer is deleted.
+    juce::FlacAudioFormat flac;
+    std::unique_ptr<juce::AudioFormatWriter> writer(flac.createWriterFor(new juce::MemoryOutputStream(flacBlock, false), sampleRate,
+                                                                         (unsigned int)source->getNumChannels(), upload::flacBitsPerSample,
+                                                                         {}, upload::flacQuality));
+
+    if (writer == nullptr)
+        return false;
+
+    //Deleting the writer finishes the stream.
+    const bool written = writer->writeFromAudioSampleBuffer(*source, 0, numSamples);
+    writer.reset();
+    return written;
+}
+
+const juce::MemoryBlock& UploadEncoder::getBlock() const
+{
+    return lastWasFlac ? flacBlock : wavEncoder.getBlock();
+}
+
+juce::String UploadEncoder::getWireName(int format)
+{
+    return upload::formatNames[format];
+}
+
+juce::String UploadEncoder::getMimeType(int format)
+{
+    return format == UploadFormat::FLAC ? "audio/flac" : "audio/wav";
+}
+
+juce::String UploadEncoder::getFileName(int format)
+{
+    return format == UploadFormat::FLAC ? "audio.flac" : "audio.wav";
+}
+
+int UploadEncoder::findFormat(const juce::String& wireName)
+{
+    return upload::formatNames.indexOf(wireName.trim(), true);
+}
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    UploadEncoder.h
+    Created: 19 Oct 2026 5:18:02pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Config.h"
+#include "WavEncoder.h"
+
+//==============================================================================
+/**
+    Encodes a capture window in one of the UploadFormat request body formats.
+
+    WAV goes through WavEncoder, FLAC through JUCE's FLAC writer. Both write
+    into blocks that are kept between calls, so after the first evaluation of
+    a window length the encoder no longer allocates for the body. Worker
+    threads only: FLAC encoding is far too slow for the audio thread.
+
+    Each format has a wire name (upload::formatNames) that is sent in the
+    upload::formatHeader request header, so the server knows how to decode the
+    body without sniffing it.
+*/
+class UploadEncoder
+{
+public:
+    UploadEncoder() = default;
+
+    //downmixToMid encodes the average of the first two channels as mono.
+    bool encode(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, int format, bool downmixToMid);
+
+    //The last encoded body.
+    const juce::MemoryBlock& getBlock() const;
+
+    static juce::String getWireName(int format);
+    static juce::String getMimeType(int format);
+    static juce::String getFileName(int format);
+
+    //-1 if the name is not a format this encoder can write.
+    static int findFormat(const juce::String& wireName);
+
+private:
+    bool encodeFlac(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, bool downmixToMid);
+
+    WavEncoder wavEncoder;
+    juce::MemoryBlock flacBlock;
+    bool lastWasFlac = false;
+
+    //Mono downmix for FLAC, WavEncoder mixes down by itself.
+    juce::AudioBuffer<float> bufMid;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(UploadEncoder)
+};
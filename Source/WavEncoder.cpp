@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    WavEncoder.cpp
+    Created: 17 Oct 2026 5:02:33pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "WavEncoder.h"
+#include "RealtimeChecks.h"
+
+namespace
+{
+    constexpr size_t headerSize = 44;
+
+    void writeTag(char* dest, const char* tag)
+    {
+        std::memcpy(dest, tag, 4);
+    }
+
+    void writeLE16(char* dest, juce::uint16 value)
+    {
+        dest[0] = (char)(value & 0xff);
+        dest[1] = (char)(value >> 8);
+    }
+
+    void writeLE32(char* dest, juce::uint32 value)
+    {
+        for (int i = 0; i < 4; ++i)
+            dest[i] = (char)((value >> (8 * i)) & 0xff);
+    }
+
+    int toInt(float sample, float scale)
+    {
+        return juce::roundToInt(juce::jlimit(-1.0f, 1.0f, sample) * scale);
+    }
+}
+
+bool WavEncoder::encode(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, int bitsPerSample, bool downmixToMid)
+{
+    CHORUSFIND_RT_UNSAFE("WavEncoder::encode")
+
+    if (bitsPerSample != 16 && bitsPerSample != 24 && bitsPerSample != 32)
+        return false;
+
+    const bool mid = downmixToMid && buffer.getNumChannels() > 1;
+    const int numChannels = mid ? 1 : buffer.getNumChannels();
+    const int bytesPerSample = bitsPerSample / 8;
+    const size_t dataSize = (size_t)numSamples * (size_t)numChannels * (size_t)bytesPerSample;
+
+    //Same size as last time means no reallocation.
+    if (block.getSize() != headerSize + dataSize)
+        block.setSize(headerSize + dataSize);
+
+    auto* out = static_cast<char*>(block.getData());
+
+    //RIFF header
+    writeTag(out, "RIFF");
+    writeLE32(out + 4, (juce::uint32)(36 + dataSize));
+    writeTag(out + 8, "WAVE");
+
+    //fmt chunk: PCM (1) or IEEE float (3)
+    writeTag(out + 12, "fmt ");
+    writeLE32(out + 16, 16);
+    writeLE16(out + 20, bitsPerSample == 32 ? 3 : 1);
+    writeLE16(out + 22, (juce::uint16)numChannels);
+    writeLE32(out + 24, (juce::uint32)sampleRate);
+    writeLE32(out + 28, (juce::uint32)(sampleRate * numChannels * bytesPerSample));
+    writeLE16(out + 32, (juce::uint16)(numChannels * bytesPerSample));
+    writeLE16(out + 34, (juce::uint16)bitsPerSample);
+
+    writeTag(out + 36, "data");
+    writeLE32(out + 40, (juce::uint32)dataSize);
+
+    //Interleaved little-endian samples
+    auto* dest = out + headerSize;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float sample = mid ? 0.5f * (buffer.getReadPointer(0)[i] + buffer.getReadPointer(1)[i])
+                                     : buffer.getReadPointer(channel)[i];
+
+            if (bitsPerSample == 16)
+            {
+                writeLE16(dest, (juce::uint16)toInt(sample, 32767.0f));
+            }
+            else if (bitsPerSample == 24)
+            {
+                const auto value = (juce::uint32)toInt(sample, 8388607.0f);
+                dest[0] = (char)(value & 0xff);
+                dest[1] = (char)((value >> 8) & 0xff);
+                dest[2] = (char)((value >> 16) & 0xff);
+            }
+            else
+            {
+                juce::uint32 bits;
+                std::memcpy(&bits, &sample, sizeof(bits));
+                writeLE32(dest, bits);
+            }
+
+            dest += bytesPerSample;
+        }
+    }
+
+    return true;
+}
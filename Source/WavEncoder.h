@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    WavEncoder.h
+    Created: 17 Oct 2026 5:02:33pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Encodes an AudioBuffer as a WAV file image in memory.
+
+    The output block is reused between calls and only reallocated when the
+    encoded size changes, so repeated evaluations of the same window length do
+    no allocation and no file I/O.
+*/
+class WavEncoder
+{
+public:
+    WavEncoder() = default;
+
+    //Supports 16 and 24 bit integer PCM and 32 bit float. downmixToMid writes a mono file of the first two channels' average.
+    bool encode(const juce::AudioBuffer<float>& buffer, int numSamples, double sampleRate, int bitsPerSample, bool downmixToMid = false);
+
+    //The last encoded file, exactly getBlock().getSize() bytes long.
+    const juce::MemoryBlock& getBlock() const
+    {
+        return block;
+    }
+
+private:
+    juce::MemoryBlock block;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WavEncoder)
+};
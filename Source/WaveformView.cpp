@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    WaveformView.cpp
+    Created: 20 Oct 2026 2:51:08pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#include "WaveformView.h"
+
+WaveformView::WaveformView(PeakFifo& fifoToUse, const StereoMeter& stereoMeterToShow)
+    : fifo(fifoToUse)
+    , stereoMeter(stereoMeterToShow)
+{
+    history.insertMultiple(0, {}, (int)(display::waveformSeconds * display::peaksPerSecond));
+    meterDb[0] = meterDb[1] = display::meterFloorDb;
+
+    //Frames that piled up while no editor was open are stale.
+    PeakFifo::Frame frame;
+
+    while (fifo.pop(frame)) {}
+
+    setOpaque(true);
+    startTimerHz(display::refreshHz);
+}
+
+juce::Rectangle<int> WaveformView::getWaveformArea() const
+{
+    return getLocalBounds().withTrimmedRight(22).withTrimmedBottom(16);
+}
+
+juce::Rectangle<int> WaveformView::getStereoArea() const
+{
+    return getLocalBounds().withTrimmedRight(22).removeFromBottom(16);
+}
+
+juce::Rectangle<int> WaveformView::getMeterArea() const
+{
+    return getLocalBounds().removeFromRight(18);
+}
+
+void WaveformView::timerCallback()
+{
+    if (! isShowing())
+        return;
+
+    float framePeak[2] = { 0.0f, 0.0f };
+    bool hasNewFrames = false;
+    PeakFifo::Frame frame;
+
+    while (fifo.pop(frame))
+    {
+        history.setUnchecked(writeIndex, frame);
+        writeIndex = (writeIndex + 1) % history.size();
+        hasNewFrames = true;
+
+        for (int channel = 0; channel < 2; ++channel)
+            framePeak[channel] = juce::jmax(framePeak[channel], -frame.min[channel], frame.max[channel]);
+    }
+
+    bool meterChanged = false;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float fallen = juce::jmax(display::meterFloorDb, meterDb[channel] - display::meterDecayDbPerSecond / display::refreshHz);
+        const float level = juce::jmax(fallen, juce::Decibels::gainToDecibels(framePeak[channel], display::meterFloorDb));
+
+        meterChanged = meterChanged || level != meterDb[channel];
+        meterDb[channel] = level;
+    }
+
+    //Readout changes below display resolution are not worth a repaint.
+    const auto values = stereoMeter.getValues();
+    const bool stereoChanged = std::abs(values.correlation - stereoValues.correlation) > 0.005f
+                            || std::abs(values.indicator - stereoValues.indicator) > 0.005f;
+
+    if (stereoChanged)
+        stereoValues = values;
+
+    if (hasNewFrames)
+        repaint();
+    else if (meterChanged || stereoChanged)
+        repaint((meterChanged ? getMeterArea() : juce::Rectangle<int>()).getUnion(stereoChanged ? getStereoArea() : juce::Rectangle<int>()));
+}
+
+void WaveformView::paint(juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId).darker(0.3f));
+
+    //Left channel in the upper half, right in the lower.
+    const auto area = getWaveformArea();
+    const float laneHeight = area.getHeight() * 0.5f;
+    const int numFrames = history.size();
+
+    g.setColour(juce::Colours::lightgreen);
+
+    for (int x = 0; x < area.getWidth(); ++x)
+    {
+        const auto& column = history.getReference((writeIndex + x * numFrames / area.getWidth()) % numFrames);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const float centre = area.getY() + laneHeight * (channel + 0.5f);
+            const float top = centre - juce::jlimit(0.0f, 1.0f, column.max[channel]) * laneHeight * 0.5f;
+            const float bottom = centre - juce::jlimit(-1.0f, 0.0f, column.min[channel]) * laneHeight * 0.5f;
+
+            g.fillRect((float)(area.getX() + x), top, 1.0f, juce::jmax(1.0f, bottom - top));
+        }
+    }
+
+    //Correlation bar from the centre (0) towards -1 on the left or +1 on the right, then the readout.
+    auto stereo = getStereoArea().reduced(0, 2);
+    auto correlationBar = stereo.removeFromLeft(80).toFloat();
+    const float centreX = correlationBar.getCentreX();
+    const float barEnd = centreX + stereoValues.correlation * correlationBar.getWidth() * 0.5f;
+
+    g.setColour(juce::Colours::grey);
+    g.drawRect(correlationBar, 1.0f);
+    g.setColour(stereoValues.correlation < 0.0f ? juce::Colours::orange : juce::Colours::lightblue);
+    g.fillRect(juce::Rectangle<float>(juce::jmin(centreX, barEnd), correlationBar.getY() + 2.0f,
+                                      std::abs(barEnd - centreX), correlationBar.getHeight() - 4.0f));
+
+    g.setColour(juce::Colours::white);
+    g.setFont(juce::Font(11.0f));
+    g.drawText("corr " + juce::String(stereoValues.correlation, 2) + "  side " + juce::String(juce::roundToInt(stereoValues.sideRatio * 100.0f))
+                   + "%  mod " + juce::String(stereoValues.modulation, 3) + "  quick " + juce::String(juce::roundToInt(stereoValues.indicator * 100.0f)) + "%",
+               stereo.withTrimmedLeft(6), juce::Justification::centredLeft, true);
+
+    //Meter bars, full height is 0 dBFS.
+    auto meter = getMeterArea();
+    const int barWidth = meter.getWidth() / 2;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        auto bar = meter.removeFromLeft(barWidth).reduced(1, 0);
+        const float proportion = juce::jmap(meterDb[channel], display::meterFloorDb, 0.0f, 0.0f, 1.0f);
+
+        g.setColour(meterDb[channel] > -3.0f ? juce::Colours::orange : juce::Colours::lightgreen);
+        g.fillRect(bar.removeFromBottom(juce::roundToInt(proportion * bar.getHeight())));
+    }
+}
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    WaveformView.h
+    Created: 20 Oct 2026 2:51:08pm
+    Author:  Uditha
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "PeakFifo.h"
+#include "StereoMeter.h"
+
+//==============================================================================
+/**
+    Scrolling min/max waveform of the last display::waveformSeconds of input,
+    with a stereo peak meter on the right and the StereoMeter values along
+    the bottom: a -1..+1 correlation bar and the rough chorus indicator.
+
+    Drains the processor's PeakFifo display::refreshHz times a second and only
+    repaints when something changed: the whole view for new frames, just the
+    meter while it falls back after the input went quiet, nothing once it has.
+    Hidden views do not drain at all.
+*/
+class WaveformView : public juce::Component,
+                     private juce::Timer
+{
+public:
+    WaveformView(PeakFifo& fifoToUse, const StereoMeter& stereoMeterToShow);
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    PeakFifo& fifo;
+    const StereoMeter& stereoMeter;
+    StereoMeter::Values stereoValues;
+
+    //Oldest frame at writeIndex.
+    juce::Array<PeakFifo::Frame> history;
+    int writeIndex = 0;
+
+    float meterDb[2];
+
+    juce::Rectangle<int> getWaveformArea() const;
+    juce::Rectangle<int> getMeterArea() const;
+    juce::Rectangle<int> getStereoArea() const;
+
+    void timerCallback() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformView)
+};
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""
+Reference stand-in for a local ChorusFind analysis daemon.
+
+Creates the shared file the plugin's Daemon backend maps (layout in
+Source/SharedMemoryClient.h) and answers the requests instances write into
+its slots. Scoring is the same as standin_server.py: the placeholder
+1 - L/R correlation, a fixed value, or with --model the numpy reference in
+chorus_model.py.
+
+The default file is the plugin's: ChorusFind/AnalysisDaemon.shm in the
+user's application data folder. CHORUSFIND_DAEMON_FILE overrides it on both
+sides, e.g. to put it on /dev/shm.
+
+    python3 Tools/analysis_daemon.py [--file PATH] [--slots 16] [--seconds 11] [--rate 12000]
+                                     [--delay-ms 0] [--fixed-result 0.7] [--model ChorusModel.cfmodel]
+
+Python has no atomics, so the mailbox words are plain aligned 32-bit loads and
+stores written in order, which x86 keeps in order. A production daemon uses
+acquire loads of requestSeq and a release store of responseSeq. Requests are
+polled every --poll-ms.
+"""
+
+import argparse
+import mmap
+import os
+import signal
+import struct
+import sys
+import time
+
+from standin_server import placeholder_score
+
+try:
+    import chorus_model
+except ImportError:
+    chorus_model = None
+
+MAGIC = 0x4D534643  # "CFSM"
+VERSION = 1
+STOPPED, RUNNING = 0, 1
+STATUS_OK, STATUS_REJECTED, STATUS_FAILED = 0, 1, 2
+
+HEADER_BYTES = 64
+SLOT_HEADER_BYTES = 64
+MAX_CHANNELS = 2
+
+# Offsets in the header and in each slot header.
+STATE = 8
+OWNER, REQUEST_SEQ, RESPONSE_SEQ, NUM_CHANNELS, NUM_FRAMES, SAMPLE_RATE, STATUS, RESULT = range(0, 32, 4)
+
+
+def default_file():
+    """userApplicationDataDirectory as JUCE resolves it."""
+    override = os.environ.get("CHORUSFIND_DAEMON_FILE")
+    if override:
+        return override
+    if sys.platform == "win32":
+        base = os.environ.get("APPDATA", os.path.expanduser("~"))
+    elif sys.platform == "darwin":
+        base = os.path.expanduser("~/Library")
+    else:
+        base = os.path.expanduser("~/.config")
+    return os.path.join(base, "ChorusFind", "AnalysisDaemon.shm")
+
+
+def stop_existing(path):
+    """Marks a file left by an earlier daemon stopped, so mapped instances move to the new one."""
+    try:
+        with open(path, "r+b") as existing:
+            head = existing.read(12)
+            if len(head) == 12 and struct.unpack_from("<II", head) == (MAGIC, VERSION):
+                existing.seek(STATE)
+                existing.write(struct.pack("<I", STOPPED))
+    except OSError:
+        pass
+
+
+def create(path, num_slots, slot_frames):
+    slot_bytes = SLOT_HEADER_BYTES + MAX_CHANNELS * slot_frames * 4
+    slot_bytes = (slot_bytes + 63) // 64 * 64
+    size = HEADER_BYTES + num_slots * slot_bytes
+
+    # A new file rather than rewriting the old one: instances still mapping it must not see it shrink.
+    os.makedirs(os.path.dirname(os.path.abspath(path)), exist_ok=True)
+    stop_existing(path)
+    temp = path + ".new"
+    with open(temp, "wb") as out:
+        out.truncate(size)
+    os.replace(temp, path)
+
+    handle = open(path, "r+b")
+    shared = mmap.mmap(handle.fileno(), size)
+    struct.pack_into("<IIIIIII", shared, 0, MAGIC, VERSION, STOPPED, num_slots, slot_frames, MAX_CHANNELS, slot_bytes)
+    return handle, shared, slot_bytes
+
+
+def word(shared, offset):
+    return struct.unpack_from("<I", shared, offset)[0]
+
+
+def serve(options):
+    slot_frames = int(options.seconds * options.rate)
+    handle, shared, slot_bytes = create(options.file, options.slots, slot_frames)
+    model = chorus_model.read_model(options.model) if options.model else None
+    answered = [0] * options.slots
+
+    running = [True]
+    signal.signal(signal.SIGINT, lambda *_: running.__setitem__(0, False))
+    signal.signal(signal.SIGTERM, lambda *_: running.__setitem__(0, False))
+
+    struct.pack_into("<I", shared, STATE, RUNNING)
+    print("ChorusFind analysis daemon on %s, %d slots of %d frames" % (options.file, options.slots, slot_frames))
+
+    try:
+        while running[0]:
+            busy = False
+            for index in range(options.slots):
+                slot = HEADER_BYTES + index * slot_bytes
+                request = word(shared, slot + REQUEST_SEQ)
+                if request == answered[index] or word(shared, slot + OWNER) == 0:
+                    continue
+
+                busy = True
+                num_channels, num_frames, rate = struct.unpack_from("<iii", shared, slot + NUM_CHANNELS)
+                status, result = analyse(shared, slot, num_channels, num_frames, rate, slot_frames, options, model)
+
+                struct.pack_into("<if", shared, slot + STATUS, status, result)
+                struct.pack_into("<I", shared, slot + RESPONSE_SEQ, request)
+                answered[index] = request
+
+            if not busy:
+                time.sleep(options.poll_ms / 1000.0)
+    finally:
+        struct.pack_into("<I", shared, STATE, STOPPED)
+        shared.flush()
+        shared.close()
+        handle.close()
+
+
+def analyse(shared, slot, num_channels, num_frames, rate, slot_frames, options, model):
+    if not 1 <= num_channels <= MAX_CHANNELS or not 0 < num_frames <= slot_frames or rate <= 0:
+        return STATUS_REJECTED, 0.5
+
+    audio = memoryview(shared)[slot + SLOT_HEADER_BYTES:slot + SLOT_HEADER_BYTES + MAX_CHANNELS * slot_frames * 4].cast("f")
+    channels = [audio[c * slot_frames:c * slot_frames + num_frames].tolist() for c in range(num_channels)]
+    audio.release()
+
+    if options.delay_ms > 0:
+        time.sleep(options.delay_ms / 1000.0)
+    if options.fixed_result is not None:
+        return STATUS_OK, options.fixed_result
+
+    try:
+        if model is not None:
+            result = chorus_model.infer(model, channels, rate)
+            return (STATUS_REJECTED, 0.5) if result is None else (STATUS_OK, result)
+        return STATUS_OK, placeholder_score(channels)
+    except Exception as error:  # a bad window must not take the daemon down
+        print("analysis failed: %s" % error, file=sys.stderr)
+        return STATUS_FAILED, 0.5
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--file", default=default_file())
+    parser.add_argument("--slots", type=int, default=16, help="instances that can hold a slot at once")
+    parser.add_argument("--seconds", type=float, default=11.0, help="longest window, longer than the longest capture")
+    parser.add_argument("--rate", type=float, default=12000.0, help="rate the windows arrive at (analysis::targetRate)")
+    parser.add_argument("--poll-ms", type=float, default=0.5)
+    parser.add_argument("--delay-ms", type=float, default=0.0, help="simulated analysis time per result")
+    parser.add_argument("--fixed-result", type=float, default=None, help="always answer this value")
+    parser.add_argument("--model", default=None, help="score with this chorus model file (needs numpy)")
+    options = parser.parse_args()
+    if options.model and chorus_model is None:
+        parser.error("--model needs numpy")
+
+    serve(options)
+
+
+if __name__ == "__main__":
+    main()
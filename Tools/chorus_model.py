@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""
+Reference implementation of the ChorusFind model file and its inference.
+
+The plugin's ModelRunner (Source/ModelRunner.cpp) computes the same features
+and network in float32. On identical samples its result matches infer() here
+within model::tolerance in Source/Config.h.
+
+Features, per frame of fft_size samples every round(hop_seconds * rate):
+  mid = (L + R) / 2, side = (L - R) / 2, periodic Hann window,
+  power = |rfft|^2 / fft_size, HTK mel triangles between min_hz and
+  min(max_hz, rate / 2) without area normalisation,
+  feature = (ln(mel + 1e-6) - mean) * scale, mid bands first, then side.
+
+    python3 Tools/chorus_model.py init --out ChorusModel.cfmodel [--seed 1]
+    python3 Tools/chorus_model.py run --model ChorusModel.cfmodel --wav window.wav
+
+"init" writes the default architecture with random weights, for exercising
+the plumbing. A trained model is written with write_model() from the
+training code.
+
+Needs numpy.
+"""
+
+import argparse
+import struct
+import sys
+
+import numpy as np
+
+MAGIC = 0x4C4D4643  # "CFML"
+VERSION = 1
+
+CONV1D, DENSE, RELU, MEAN_POOL, SIGMOID = range(5)
+LOG_FLOOR = 1e-6
+
+
+def write_model(path, front_end, mean, scale, layers):
+    """front_end: dict(num_mels, min_hz, max_hz, fft_size, hop_seconds).
+    layers: list of (type, weights, bias), weights shaped [out][kernel][in] for
+    conv1d and [out][in] for dense, None for the others."""
+    with open(path, "wb") as out:
+        out.write(struct.pack("<ii", MAGIC, VERSION))
+        out.write(struct.pack("<iffif", front_end["num_mels"], front_end["min_hz"], front_end["max_hz"],
+                              front_end["fft_size"], front_end["hop_seconds"]))
+        out.write(struct.pack("<i", len(mean)))
+        out.write(np.asarray(mean, "<f4").tobytes())
+        out.write(np.asarray(scale, "<f4").tobytes())
+        out.write(struct.pack("<i", len(layers)))
+        for kind, weights, bias in layers:
+            out.write(struct.pack("<i", kind))
+            if kind == CONV1D:
+                num_out, kernel, num_in = weights.shape
+                out.write(struct.pack("<iii", num_in, num_out, kernel))
+            elif kind == DENSE:
+                num_out, num_in = weights.shape
+                out.write(struct.pack("<ii", num_in, num_out))
+            else:
+                continue
+            out.write(np.asarray(weights, "<f4").tobytes())
+            out.write(np.asarray(bias, "<f4").tobytes())
+
+
+def read_model(path):
+    with open(path, "rb") as source:
+        data = source.read()
+    offset = 0
+
+    def take(fmt):
+        nonlocal offset
+        values = struct.unpack_from(fmt, data, offset)
+        offset += struct.calcsize(fmt)
+        return values
+
+    def floats(count):
+        nonlocal offset
+        values = np.frombuffer(data, "<f4", count, offset).astype(np.float64)
+        offset += 4 * count
+        return values
+
+    magic, version = take("<ii")
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a chorus model file, or a newer version")
+
+    num_mels, min_hz, max_hz, fft_size, hop_seconds = take("<iffif")
+    front_end = dict(num_mels=num_mels, min_hz=min_hz, max_hz=max_hz, fft_size=fft_size, hop_seconds=hop_seconds)
+    num_features, = take("<i")
+    mean = floats(num_features)
+    scale = floats(num_features)
+
+    layers = []
+    for _ in range(take("<i")[0]):
+        kind, = take("<i")
+        if kind == CONV1D:
+            num_in, num_out, kernel = take("<iii")
+            layers.append((kind, floats(num_out * kernel * num_in).reshape(num_out, kernel, num_in), floats(num_out)))
+        elif kind == DENSE:
+            num_in, num_out = take("<ii")
+            layers.append((kind, floats(num_out * num_in).reshape(num_out, num_in), floats(num_out)))
+        else:
+            layers.append((kind, None, None))
+
+    return front_end, mean, scale, layers
+
+
+def hz_to_mel(hz):
+    return 2595.0 * np.log10(1.0 + hz / 700.0)
+
+
+def mel_to_hz(mel):
+    return 700.0 * (10.0 ** (mel / 2595.0) - 1.0)
+
+
+def mel_filters(front_end, rate):
+    fft_size = front_end["fft_size"]
+    num_mels = front_end["num_mels"]
+    max_hz = min(float(front_end["max_hz"]), rate * 0.5)
+    edges = mel_to_hz(np.linspace(hz_to_mel(float(front_end["min_hz"])), hz_to_mel(max_hz), num_mels + 2))
+    hz = np.arange(fft_size // 2 + 1) * rate / fft_size
+
+    lower, centre, upper = edges[:-2, None], edges[1:-1, None], edges[2:, None]
+    return np.maximum(0.0, np.minimum((hz - lower) / (centre - lower), (upper - hz) / (upper - centre)))
+
+
+def log_mel(left, right, rate, front_end, mean, scale):
+    """frames x (2 * num_mels) normalised features."""
+    fft_size = front_end["fft_size"]
+    hop = max(1, int(np.floor(front_end["hop_seconds"] * rate + 0.5)))
+    num_frames = 1 + (len(left) - fft_size) // hop if len(left) >= fft_size else 0
+
+    window = 0.5 - 0.5 * np.cos(2.0 * np.pi * np.arange(fft_size) / fft_size)
+    filters = mel_filters(front_end, rate)
+    left = np.asarray(left, np.float64)
+    right = np.asarray(right, np.float64)
+
+    bands = []
+    for signal in (0.5 * (left + right), 0.5 * (left - right)):
+        frames = np.stack([signal[f * hop:f * hop + fft_size] * window for f in range(num_frames)])
+        power = np.abs(np.fft.rfft(frames, axis=1)) ** 2 / fft_size
+        bands.append(power @ filters.T)
+
+    return (np.log(np.concatenate(bands, axis=1) + LOG_FLOOR) - mean) * scale
+
+
+def forward(features, layers):
+    x = features
+    for kind, weights, bias in layers:
+        if kind == CONV1D:
+            kernel = weights.shape[1]
+            windows = np.stack([x[t:t + kernel].reshape(-1) for t in range(len(x) - kernel + 1)])
+            x = windows @ weights.reshape(len(weights), -1).T + bias
+        elif kind == DENSE:
+            x = x @ weights.T + bias
+        elif kind == RELU:
+            x = np.maximum(x, 0.0)
+        elif kind == MEAN_POOL:
+            x = x.mean(axis=0, keepdims=True)
+        elif kind == SIGMOID:
+            x = 1.0 / (1.0 + np.exp(-x))
+    return float(np.clip(x[0, 0], 0.0, 1.0))
+
+
+def infer(model, channels, rate):
+    """0-1 chorus amount of the first two channels, None if the window is too short."""
+    front_end, mean, scale, layers = model
+    right = channels[1] if len(channels) > 1 else channels[0]
+    features = log_mel(channels[0], right, rate, front_end, mean, scale)
+
+    min_frames = 1 + sum(w.shape[1] - 1 for kind, w, _ in layers if kind == CONV1D)
+    if len(features) < min_frames:
+        return None
+    return forward(features, layers)
+
+
+def default_model(seed):
+    """Small CNN on 2 x 32 log-mel bands, random weights."""
+    rng = np.random.default_rng(seed)
+    front_end = dict(num_mels=32, min_hz=60.0, max_hz=6000.0, fft_size=512, hop_seconds=0.016)
+    num_features = 2 * front_end["num_mels"]
+
+    def init(*shape):
+        return rng.normal(0.0, np.sqrt(2.0 / np.prod(shape[1:])), shape)
+
+    layers = [
+        (CONV1D, init(32, 5, num_features), np.zeros(32)),
+        (RELU, None, None),
+        (CONV1D, init(32, 3, 32), np.zeros(32)),
+        (RELU, None, None),
+        (MEAN_POOL, None, None),
+        (DENSE, init(16, 32), np.zeros(16)),
+        (RELU, None, None),
+        (DENSE, init(1, 16), np.zeros(1)),
+        (SIGMOID, None, None),
+    ]
+    return front_end, np.full(num_features, -8.0), np.full(num_features, 0.25), layers
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    commands = parser.add_subparsers(dest="command", required=True)
+    init_command = commands.add_parser("init", help="write the default architecture with random weights")
+    init_command.add_argument("--out", required=True)
+    init_command.add_argument("--seed", type=int, default=1)
+    run_command = commands.add_parser("run", help="score a WAV file")
+    run_command.add_argument("--model", required=True)
+    run_command.add_argument("--wav", required=True)
+    options = parser.parse_args()
+
+    if options.command == "init":
+        front_end, mean, scale, layers = default_model(options.seed)
+        write_model(options.out, front_end, mean, scale, layers)
+        return 0
+
+    sys.path.insert(0, __file__.rsplit("/", 1)[0])
+    from standin_server import read_wav
+
+    with open(options.wav, "rb") as source:
+        rate, channels = read_wav(source.read())
+    result = infer(read_model(options.model), channels, rate)
+    if result is None:
+        print("window too short for the model", file=sys.stderr)
+        return 1
+    print("%.6f" % result)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
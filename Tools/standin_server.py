@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the ChorusFind analysis server.
+
+Implements the endpoints the plugin talks to, using only the standard library,
+so the HTTP backend can be exercised without the real model:
+
+  POST /process-audio/        multipart/form-data, field "audio" holds the encoded window
+  POST /process-audio-chunk/  ?session=<id>&seq=<n>&final=<0|1>, body is one encoded chunk
+
+Both answer {"result": <0-1>} once the whole window is known. The value is a
+cheap placeholder (1 - L/R correlation), or with --model the output of the
+numpy reference in chorus_model.py, which the plugin's Model backend matches.
+
+The X-Audio-Format request header names the body format (wav24, wav16, flac),
+WAV is assumed without it. A format the server cannot decode is answered with
+415 and the X-Accept-Audio-Format header listing the ones it can. FLAC needs
+the soundfile module or the flac command line tool.
+
+    python3 Tools/standin_server.py --port 8000 [--delay-ms 50] [--fixed-result 0.7] [--formats wav24,wav16]
+                                    [--model ChorusModel.cfmodel]
+"""
+
+import argparse
+import io
+import json
+import math
+import shutil
+import struct
+import subprocess
+import threading
+import wave
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+try:
+    import chorus_model
+except ImportError:
+    chorus_model = None
+
+
+def read_wav(data):
+    """Returns (sample_rate, channels) with channels as lists of floats."""
+    with wave.open(io.BytesIO(data)) as wav:
+        num_channels = wav.getnchannels()
+        width = wav.getsampwidth()
+        frames = wav.readframes(wav.getnframes())
+        rate = wav.getframerate()
+
+    if width == 2:
+        samples = [s / 32768.0 for s in struct.unpack("<%dh" % (len(frames) // 2), frames)]
+    elif width == 3:
+        samples = []
+        for i in range(0, len(frames), 3):
+            value = int.from_bytes(frames[i:i + 3], "little", signed=True)
+            samples.append(value / 8388608.0)
+    elif width == 4:
+        samples = list(struct.unpack("<%df" % (len(frames) // 4), frames))
+    else:
+        raise ValueError("unsupported sample width %d" % width)
+
+    return rate, [samples[c::num_channels] for c in range(num_channels)]
+
+
+def read_flac(data):
+    """Same as read_wav, for a FLAC stream."""
+    try:
+        import soundfile
+        frames, rate = soundfile.read(io.BytesIO(data), dtype="float32", always_2d=True)
+        return rate, [frames[:, c].tolist() for c in range(frames.shape[1])]
+    except ImportError:
+        decoded = subprocess.run(["flac", "--decode", "--stdout", "--silent", "-"], input=data,
+                                 stdout=subprocess.PIPE, check=True).stdout
+        return read_wav(decoded)
+
+
+def flac_available():
+    try:
+        import soundfile  # noqa: F401
+        return True
+    except ImportError:
+        return shutil.which("flac") is not None
+
+
+DECODERS = {"wav24": read_wav, "wav16": read_wav, "flac": read_flac}
+
+
+def placeholder_score(channels):
+    left = channels[0]
+    right = channels[1] if len(channels) > 1 else channels[0]
+    energy_l = sum(x * x for x in left)
+    energy_r = sum(x * x for x in right)
+    if energy_l == 0.0 or energy_r == 0.0:
+        return 0.0
+    correlation = sum(l * r for l, r in zip(left, right)) / math.sqrt(energy_l * energy_r)
+    return min(1.0, max(0.0, 1.0 - correlation))
+
+
+def multipart_field(body, content_type, field):
+    boundary = content_type.split("boundary=")[-1].strip('"').encode()
+    for part in body.split(b"--" + boundary):
+        head, _, payload = part.partition(b"\r\n\r\n")
+        if ('name="%s"' % field).encode() in head:
+            return payload[:-2] if payload.endswith(b"\r\n") else payload
+    return None
+
+
+class Sessions:
+    """Chunks of streamed uploads, per session id."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.sessions = {}
+
+    def add(self, session, seq, channels):
+        with self.lock:
+            expected, stored = self.sessions.get(session, (0, None))
+            if seq != expected:
+                return False
+            if stored is None:
+                stored = [list(c) for c in channels]
+            else:
+                for target, chunk in zip(stored, channels):
+                    target.extend(chunk)
+            self.sessions[session] = (seq + 1, stored)
+            return True
+
+    def finish(self, session):
+        with self.lock:
+            return self.sessions.pop(session, (0, None))[1]
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def reply(self, status, payload, headers=None):
+        body = json.dumps(payload).encode()
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(body)))
+        for name, value in (headers or {}).items():
+            self.send_header(name, value)
+        self.end_headers()
+        self.wfile.write(body)
+
+    def decode(self, data):
+        """Returns (rate, channels) or None after answering 415."""
+        name = self.headers.get("X-Audio-Format", "wav24").strip().lower()
+        if name not in self.server.formats:
+            accepted = ", ".join(self.server.formats)
+            self.reply(415, {"error": "unsupported audio format %s" % name}, {"X-Accept-Audio-Format": accepted})
+            return None
+        self.server.bytes_received += len(data)
+        return DECODERS[name](data)
+
+    def result_for(self, rate, channels):
+        if self.server.options.delay_ms > 0:
+            threading.Event().wait(self.server.options.delay_ms / 1000.0)
+        if self.server.options.fixed_result is not None:
+            return self.server.options.fixed_result
+        if self.server.model is not None:
+            result = chorus_model.infer(self.server.model, channels, rate)
+            if result is None:
+                raise ValueError("window too short for the model")
+            return result
+        return placeholder_score(channels)
+
+    def do_POST(self):
+        url = urlparse(self.path)
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0)))
+
+        try:
+            if url.path.rstrip("/") == "/process-audio":
+                data = multipart_field(body, self.headers.get("Content-Type", ""), "audio")
+                if data is None:
+                    return self.reply(400, {"error": "missing audio field"})
+                decoded = self.decode(data)
+                if decoded is None:
+                    return None
+                return self.reply(200, {"result": self.result_for(*decoded)})
+
+            if url.path.rstrip("/") == "/process-audio-chunk":
+                query = parse_qs(url.query)
+                session = query["session"][0]
+                seq = int(query["seq"][0])
+                final = query.get("final", ["0"])[0] == "1"
+
+                decoded = self.decode(body)
+                if decoded is None:
+                    return None
+                if not self.server.sessions.add(session, seq, decoded[1]):
+                    return self.reply(409, {"error": "unexpected sequence number"})
+                if not final:
+                    return self.reply(200, {"status": "ok"})
+                return self.reply(200, {"result": self.result_for(decoded[0], self.server.sessions.finish(session))})
+
+        except (KeyError, ValueError, wave.Error, subprocess.CalledProcessError, RuntimeError) as error:
+            return self.reply(400, {"error": str(error)})
+
+        self.reply(404, {"error": "unknown endpoint"})
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8000)
+    parser.add_argument("--delay-ms", type=float, default=0.0, help="simulated analysis time per result")
+    parser.add_argument("--fixed-result", type=float, default=None, help="always answer this value")
+    parser.add_argument("--formats", default=None, help="comma separated formats to accept (default: all available)")
+    parser.add_argument("--model", default=None, help="score with this chorus model file (needs numpy)")
+    options = parser.parse_args()
+    if options.model and chorus_model is None:
+        parser.error("--model needs numpy")
+
+    formats = [f for f in DECODERS if f != "flac" or flac_available()]
+    if options.formats:
+        formats = [f.strip() for f in options.formats.split(",") if f.strip() in formats]
+
+    server = ThreadingHTTPServer((options.host, options.port), Handler)
+    server.options = options
+    server.sessions = Sessions()
+    server.formats = formats
+    server.bytes_received = 0
+    server.model = chorus_model.read_model(options.model) if options.model else None
+    print("ChorusFind stand-in server on http://%s:%d, formats: %s" % (options.host, options.port, ", ".join(formats)))
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()